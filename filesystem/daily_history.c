@@ -0,0 +1,209 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "daily_history.h"
+#include "filesystem.h"
+
+#define DAILY_HISTORY_HEADER_SIZE ((int32_t)sizeof(uint32_t))
+#define DAILY_HISTORY_RECORD_SIZE ((int32_t)sizeof(daily_history_record_t))
+// A longer gap is more likely a clock set wrong than a watch left in a drawer. Filling it in would eat the
+// filesystem, so the log starts over instead.
+#define DAILY_HISTORY_MAX_GAP_DAYS 366
+// Once an append would take the log past DAILY_HISTORY_MAX_DAYS (about 5.8 kB), it is rewritten with only the last
+// DAILY_HISTORY_KEEP_DAYS, which leaves room for the longest gap.
+#define DAILY_HISTORY_KEEP_DAYS 366
+#define DAILY_HISTORY_MAX_DAYS (DAILY_HISTORY_KEEP_DAYS + DAILY_HISTORY_MAX_GAP_DAYS + 1)
+
+static bool _daily_history_read(daily_history_t *history, uint32_t index, daily_history_record_t *record) {
+    if (index + 1 == history->num_days) {
+        *record = history->last;
+        return true;
+    }
+    return filesystem_read_file_at(history->filename, (char *)record,
+                                   DAILY_HISTORY_HEADER_SIZE + index * DAILY_HISTORY_RECORD_SIZE, DAILY_HISTORY_RECORD_SIZE);
+}
+
+static daily_history_record_t _daily_history_next(daily_history_t *history, daily_history_record_t previous, uint16_t value) {
+    daily_history_record_t record;
+
+    record.sum = previous.sum + value;
+    record.streak = (value >= history->streak_threshold && previous.streak < UINT16_MAX) ? previous.streak + 1 : 0;
+    record.best_streak = record.streak > previous.best_streak ? record.streak : previous.best_streak;
+
+    return record;
+}
+
+void daily_history_open(daily_history_t *history, char *filename, uint16_t streak_threshold) {
+    memset(history, 0, sizeof(daily_history_t));
+    history->filename = filename;
+    // a threshold of 0 would make every day, even the empty ones, count towards a streak
+    history->streak_threshold = streak_threshold ? streak_threshold : 1;
+
+    int32_t file_size = filesystem_get_file_size(filename);
+    if (file_size < DAILY_HISTORY_HEADER_SIZE + DAILY_HISTORY_RECORD_SIZE) return;
+
+    uint32_t num_days = (file_size - DAILY_HISTORY_HEADER_SIZE) / DAILY_HISTORY_RECORD_SIZE;
+    if (filesystem_read_file_at(filename, (char *)&history->first_day, 0, DAILY_HISTORY_HEADER_SIZE) &&
+        filesystem_read_file_at(filename, (char *)&history->last,
+                                DAILY_HISTORY_HEADER_SIZE + (num_days - 1) * DAILY_HISTORY_RECORD_SIZE, DAILY_HISTORY_RECORD_SIZE)) {
+        history->num_days = num_days;
+    }
+}
+
+uint32_t daily_history_day_number(uint32_t local_timestamp) {
+    return local_timestamp / 86400;
+}
+
+static bool _daily_history_restart(daily_history_t *history, uint32_t day) {
+    history->first_day = day;
+    history->num_days = 0;
+    memset(&history->last, 0, sizeof(daily_history_record_t));
+
+    return filesystem_write_file(history->filename, (char *)&history->first_day, DAILY_HISTORY_HEADER_SIZE);
+}
+
+// drops the records from day on, which is after first_day.
+static bool _daily_history_truncate(daily_history_t *history, uint32_t day) {
+    uint32_t num_days = day - history->first_day;
+    daily_history_record_t last;
+
+    if (!_daily_history_read(history, num_days - 1, &last)) return false;
+    if (!filesystem_truncate_file(history->filename, DAILY_HISTORY_HEADER_SIZE + num_days * DAILY_HISTORY_RECORD_SIZE)) return false;
+    history->num_days = num_days;
+    history->last = last;
+
+    return true;
+}
+
+// Drops all but the last keep records, rewriting the file from a later first_day. Sums are rebased so that every
+// day keeps its value; streaks and best streaks are kept as they were, so they still count the dropped days.
+static bool _daily_history_rotate(daily_history_t *history, uint32_t keep) {
+    if (keep == 0 || keep >= history->num_days) return false;
+
+    uint32_t drop = history->num_days - keep;
+    daily_history_record_t base;
+    if (!_daily_history_read(history, drop - 1, &base)) return false;
+
+    char *buf = malloc(DAILY_HISTORY_HEADER_SIZE + keep * DAILY_HISTORY_RECORD_SIZE);
+    if (buf == NULL) return false;
+
+    uint32_t first_day = history->first_day + drop;
+    daily_history_record_t *records = (daily_history_record_t *)(buf + DAILY_HISTORY_HEADER_SIZE);
+    memcpy(buf, &first_day, DAILY_HISTORY_HEADER_SIZE);
+    bool success = filesystem_read_file_at(history->filename, (char *)records,
+                                           DAILY_HISTORY_HEADER_SIZE + drop * DAILY_HISTORY_RECORD_SIZE, keep * DAILY_HISTORY_RECORD_SIZE);
+    if (success) {
+        for (uint32_t i = 0; i < keep; i++) records[i].sum -= base.sum;
+        success = filesystem_write_file(history->filename, buf, DAILY_HISTORY_HEADER_SIZE + keep * DAILY_HISTORY_RECORD_SIZE);
+    }
+    if (success) {
+        history->first_day = first_day;
+        history->num_days = keep;
+        history->last = records[keep - 1];
+    }
+    free(buf);
+
+    return success;
+}
+
+// Appends count records: zeroes for the missing days, then value. One write, so that a full filesystem can't leave
+// half a gap.
+static bool _daily_history_write_days(daily_history_t *history, daily_history_record_t *records, uint32_t count, uint16_t value) {
+    daily_history_record_t record = history->last;
+    for (uint32_t i = 0; i < count; i++) {
+        record = _daily_history_next(history, record, i + 1 == count ? value : 0);
+        records[i] = record;
+    }
+    if (!filesystem_append_file(history->filename, (char *)records, count * DAILY_HISTORY_RECORD_SIZE)) return false;
+
+    history->last = record;
+    history->num_days += count;
+
+    return true;
+}
+
+bool daily_history_append(daily_history_t *history, uint32_t day, uint16_t value) {
+    uint32_t next_day = history->first_day + history->num_days;
+
+    if (history->num_days == 0 || day <= history->first_day || day > next_day + DAILY_HISTORY_MAX_GAP_DAYS) {
+        if (!_daily_history_restart(history, day)) return false;
+    } else if (day < next_day) {
+        // the clock was set back; forget the days that haven't happened yet.
+        if (!_daily_history_truncate(history, day)) return false;
+    }
+
+    // fill in any days we missed, then the day itself.
+    uint32_t count = day - (history->first_day + history->num_days) + 1;
+    if (history->num_days + count > DAILY_HISTORY_MAX_DAYS && !_daily_history_rotate(history, DAILY_HISTORY_KEEP_DAYS)) return false;
+
+    daily_history_record_t *records = malloc(count * DAILY_HISTORY_RECORD_SIZE);
+    if (records == NULL) return false;
+
+    bool success = _daily_history_write_days(history, records, count, value);
+    // the filesystem is most likely full: make room by dropping the older half of the log, and try once more.
+    if (!success && _daily_history_rotate(history, history->num_days / 2)) {
+        success = _daily_history_write_days(history, records, count, value);
+    }
+    free(records);
+
+    return success;
+}
+
+uint16_t daily_history_get_value(daily_history_t *history, uint32_t day) {
+    if (day < history->first_day || day >= history->first_day + history->num_days) return 0;
+
+    uint32_t index = day - history->first_day;
+    daily_history_record_t record;
+    daily_history_record_t previous = {0};
+    if (!_daily_history_read(history, index, &record)) return 0;
+    if (index > 0 && !_daily_history_read(history, index - 1, &previous)) return 0;
+
+    return record.sum - previous.sum;
+}
+
+bool daily_history_get_stats(daily_history_t *history, uint32_t first_day, uint32_t last_day, daily_history_stats_t *stats) {
+    memset(stats, 0, sizeof(daily_history_stats_t));
+    if (history->num_days == 0) return false;
+
+    uint32_t log_last_day = history->first_day + history->num_days - 1;
+    bool have_last_day = last_day <= log_last_day;
+    if (first_day < history->first_day) first_day = history->first_day;
+    if (last_day > log_last_day) last_day = log_last_day;
+    if (first_day > last_day) return false;
+
+    daily_history_record_t end;
+    daily_history_record_t before = {0};
+    if (!_daily_history_read(history, last_day - history->first_day, &end)) return false;
+    if (first_day > history->first_day && !_daily_history_read(history, first_day - history->first_day - 1, &before)) return false;
+
+    stats->total = end.sum - before.sum;
+    stats->num_days = last_day - first_day + 1;
+    stats->streak = have_last_day ? end.streak : 0;
+    stats->best_streak = end.best_streak;
+
+    return true;
+}
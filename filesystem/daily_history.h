@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Daily history
+ *
+ * An append-only log of one value per day (active minutes, goals completed...) kept on the filesystem.
+ * Alongside each day's value, the log keeps a running total and the streak of days that met a threshold,
+ * so the total, average or streak for any range of days takes at most two record reads, no matter how
+ * many days are in the log or in the range.
+ *
+ * The file is a 4-byte header holding the day number of the first record, followed by one 8-byte
+ * daily_history_record_t per day. Days are numbered as in local time: unix time + UTC offset, / 86400.
+ * The log keeps two years at most: past that, or when the filesystem is full, it is rewritten without its
+ * oldest days. Sums are rebased, and streaks and best streaks still count the days that were dropped.
+ */
+
+typedef struct {
+    uint32_t sum;           // total of the values from the first day through this one
+    uint16_t streak;        // consecutive days, ending with this one, whose value met the threshold
+    uint16_t best_streak;   // longest such run from the first day through this one
+} daily_history_record_t;
+
+typedef struct {
+    char *filename;
+    uint16_t streak_threshold;
+    uint32_t first_day;             // day number of the first record
+    uint32_t num_days;              // number of records in the file
+    daily_history_record_t last;    // the last record, cached so that appending doesn't have to read
+} daily_history_t;
+
+typedef struct {
+    uint32_t total;         // sum of the values in the range
+    uint16_t num_days;      // number of days in the range that are in the log
+    uint16_t streak;        // streak as of the last day of the range, or 0 if that day isn't in the log
+    uint16_t best_streak;   // best streak as of the last day of the range
+} daily_history_stats_t;
+
+/** @brief Opens a daily history, reading its header and last record if the file exists.
+  * @param history The history to set up.
+  * @param filename The file backing the history. The string must outlive the history.
+  * @param streak_threshold A day counts towards a streak if its value is at least this much.
+  */
+void daily_history_open(daily_history_t *history, char *filename, uint16_t streak_threshold);
+
+/** @brief Returns the day number for a local date and time, for use with the other functions here.
+  */
+uint32_t daily_history_day_number(uint32_t local_timestamp);
+
+/** @brief Records the value for a day. Days missing between the last record and this one are logged as 0.
+  * @details If the day is already in the log, the clock was set back: that day and the ones after it are dropped
+  *          first. If the day comes before the log, or more than a year after it, the log starts over. If the log
+  *          would grow past two years, or the write fails, older days are dropped to make room.
+  * @return false if the write failed even after dropping older days.
+  */
+bool daily_history_append(daily_history_t *history, uint32_t day, uint16_t value);
+
+/** @brief Returns the value logged for a day, or 0 if the day isn't in the log.
+  */
+uint16_t daily_history_get_value(daily_history_t *history, uint32_t day);
+
+/** @brief Computes stats for the days from first_day through last_day, inclusive.
+  * @details The range is clipped to the days in the log.
+  * @return false if no day in the range is in the log; stats are zeroed in that case.
+  */
+bool daily_history_get_stats(daily_history_t *history, uint32_t first_day, uint32_t last_day, daily_history_stats_t *stats);
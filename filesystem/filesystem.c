@@ -80,6 +80,7 @@ const struct lfs_config watch_lfs_cfg = {
 lfs_t eeprom_filesystem;
 static lfs_file_t file;
 static struct lfs_info info;
+static bool filesystem_mounted = false;
 
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
@@ -91,6 +92,8 @@ static int _traverse_df_cb(void *p, lfs_block_t block) {
 int32_t filesystem_get_free_space(void) {
 	int err;
 
+	if (!filesystem_init()) return LFS_ERR_IO;
+
 	uint32_t free_blocks = 0;
 	err = lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &free_blocks);
 	if(err < 0){
@@ -140,6 +143,8 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
 }
 
 bool filesystem_init(void) {
+    if (filesystem_mounted) return true;
+
     int err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
 
     // reformat if we can't mount the filesystem
@@ -148,16 +153,21 @@ bool filesystem_init(void) {
         printf("Ignore that error! Formatting filesystem...\r\n");
         err = lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
         if (err < 0) return false;
-        err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg) == LFS_ERR_OK;
+        err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+        if (err < 0) return false;
+        filesystem_mounted = true;
         printf("Filesystem mounted with %ld bytes free.\r\n", filesystem_get_free_space());
     }
 
-    return err == LFS_ERR_OK;
+    filesystem_mounted = err == LFS_ERR_OK;
+    return filesystem_mounted;
 }
 
 int _filesystem_format(void);
 int _filesystem_format(void) {
+    if (!filesystem_init()) printf("Couldn't mount - formatting anyway.\r\n");
     int err = lfs_unmount(&eeprom_filesystem);
+    filesystem_mounted = false;
     if (err < 0) {
         printf("Couldn't unmount - continuing to format, but you should reboot afterwards!\r\n");
     }
@@ -167,17 +177,20 @@ int _filesystem_format(void) {
 
     err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
     if (err < 0) return err;
+    filesystem_mounted = true;
     printf("Filesystem re-mounted with %ld bytes free.\r\n", filesystem_get_free_space());
     return 0;
 }
 
 bool filesystem_file_exists(char *filename) {
+    if (!filesystem_init()) return false;
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
     return info.type == LFS_TYPE_REG;
 }
 
 bool filesystem_rm(char *filename) {
+    if (!filesystem_init()) return false;
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
     if (filesystem_file_exists(filename)) {
@@ -210,6 +223,19 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length) {
     return false;
 }
 
+bool filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length) {
+    int32_t file_size = filesystem_get_file_size(filename);
+    if (offset < 0 || file_size < offset + length) return false;
+
+    int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
+    if (err < 0) return false;
+    err = lfs_file_seek(&eeprom_filesystem, &file, offset, LFS_SEEK_SET);
+    if (err >= 0) err = lfs_file_read(&eeprom_filesystem, &file, buf, length);
+    int close_err = lfs_file_close(&eeprom_filesystem, &file);
+
+    return err == length && close_err == LFS_ERR_OK;
+}
+
 bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length) {
     memset(buf, 0, length + 1);
     int32_t file_size = filesystem_get_file_size(filename);
@@ -234,6 +260,7 @@ bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t le
 }
 
 static void filesystem_cat(char *filename) {
+    if (!filesystem_init()) return;
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
     if (filesystem_file_exists(filename)) {
@@ -277,7 +304,19 @@ bool filesystem_append_file(char *filename, char *text, int32_t length) {
     return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
 }
 
+bool filesystem_truncate_file(char *filename, int32_t length) {
+    if (!filesystem_init()) return false;
+
+    int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDWR);
+    if (err < 0) return false;
+    err = lfs_file_truncate(&eeprom_filesystem, &file, length);
+    int close_err = lfs_file_close(&eeprom_filesystem, &file);
+
+    return err >= 0 && close_err == LFS_ERR_OK;
+}
+
 int filesystem_cmd_ls(int argc, char *argv[]) {
+    if (!filesystem_init()) return -1;
     if (argc >= 2) {
         filesystem_ls(&eeprom_filesystem, argv[1]);
     } else {
@@ -294,6 +333,7 @@ int filesystem_cmd_cat(int argc, char *argv[]) {
 
 int filesystem_cmd_b64encode(int argc, char *argv[]) {
     (void) argc;
+    if (!filesystem_init()) return -1;
     info.type = 0;
     lfs_stat(&eeprom_filesystem, argv[1], &info);
     if (filesystem_file_exists(argv[1])) {
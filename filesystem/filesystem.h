@@ -29,6 +29,8 @@
 #include "watch.h"
 
 /** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
+  * @details The other filesystem functions call this before they touch the filesystem, so it gets mounted by
+  *          whatever needs it first. Once it is mounted, calling this again does nothing.
   * @return true if the filesystem was mounted successfully.
   */
 bool filesystem_init(void);
@@ -69,6 +71,17 @@ int32_t filesystem_get_file_size(char *filename);
   */
 bool filesystem_read_file(char *filename, char *buf, int32_t length);
 
+/** @brief Reads part of a file from the filesystem into a buffer
+  * @param filename the file you wish to read
+  * @param buf A buffer of at least length bytes; the bytes will be read into this buffer
+  * @param offset The offset into the file at which to start reading
+  * @param length The number of bytes to read
+  * @return true if all length bytes were read; false otherwise
+  * @note Unlike filesystem_read_file, this seeks straight to the requested bytes, so it's the one
+  *       to use for fixed-size records in a file too large to read in full.
+  */
+bool filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length);
+
 /** @brief Reads a line from a file into a buffer
   * @param filename the file you wish to read
   * @param buf A buffer of at least length + 1 bytes; the file will be read into this buffer,
@@ -96,6 +109,13 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/** @brief Cuts a file on the filesystem down to a given length
+  * @param filename the file you wish to truncate
+  * @param length The number of bytes to keep
+  * @return true if the truncation was successful; false otherwise
+  */
+bool filesystem_truncate_file(char *filename, int32_t length);
+
 int filesystem_cmd_ls(int argc, char *argv[]);
 int filesystem_cmd_cat(int argc, char *argv[]);
 int filesystem_cmd_b64encode(int argc, char *argv[]);
@@ -0,0 +1,245 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build and run from this directory:
+//   cc -I. -I.. test_main.c unity.c ../daily_history.c -o test_daily_history && ./test_daily_history
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "daily_history.h"
+#include "filesystem.h"
+#include "unity.h"
+
+// The log's limits, from daily_history.c.
+#define KEEP_DAYS 366
+#define MAX_GAP_DAYS 366
+#define MAX_DAYS (KEEP_DAYS + MAX_GAP_DAYS + 1)
+
+// A filesystem with room for one file, held in memory. Writes that would take it past fake_capacity fail.
+static char fake_data[8192];
+static int32_t fake_size;
+static int32_t fake_capacity;
+static uint32_t fake_writes;
+
+int32_t filesystem_get_file_size(char *filename) {
+    (void) filename;
+    return fake_size;
+}
+
+bool filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length) {
+    (void) filename;
+    if (offset < 0 || offset + length > fake_size) return false;
+    memcpy(buf, fake_data + offset, length);
+    return true;
+}
+
+bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    (void) filename;
+    if (length > fake_capacity) return false;
+    memcpy(fake_data, text, length);
+    fake_size = length;
+    fake_writes++;
+    return true;
+}
+
+bool filesystem_append_file(char *filename, char *text, int32_t length) {
+    (void) filename;
+    if (fake_size < 0 || fake_size + length > fake_capacity) return false;
+    memcpy(fake_data + fake_size, text, length);
+    fake_size += length;
+    fake_writes++;
+    return true;
+}
+
+bool filesystem_truncate_file(char *filename, int32_t length) {
+    (void) filename;
+    if (length > fake_size) return false;
+    fake_size = length;
+    return true;
+}
+
+static daily_history_t history;
+
+void setUp(void) {
+    fake_size = -1;
+    fake_capacity = sizeof(fake_data);
+    fake_writes = 0;
+    daily_history_open(&history, "test.dat", 5);
+}
+
+void tearDown(void) {
+}
+
+static void test_gap_fill(void) {
+    TEST_ASSERT_TRUE(daily_history_append(&history, 100, 6));
+    TEST_ASSERT_TRUE(daily_history_append(&history, 101, 7));
+    fake_writes = 0;
+    TEST_ASSERT_TRUE(daily_history_append(&history, 105, 8));
+
+    // the three missing days and the day itself go in a single write
+    TEST_ASSERT_EQUAL_UINT32(1, fake_writes);
+    TEST_ASSERT_EQUAL_UINT32(6, history.num_days);
+    TEST_ASSERT_EQUAL_UINT16(7, daily_history_get_value(&history, 101));
+    TEST_ASSERT_EQUAL_UINT16(0, daily_history_get_value(&history, 102));
+    TEST_ASSERT_EQUAL_UINT16(0, daily_history_get_value(&history, 104));
+    TEST_ASSERT_EQUAL_UINT16(8, daily_history_get_value(&history, 105));
+
+    // the gap breaks the streak
+    daily_history_stats_t stats;
+    TEST_ASSERT_TRUE(daily_history_get_stats(&history, 100, 105, &stats));
+    TEST_ASSERT_EQUAL_UINT32(21, stats.total);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.streak);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.best_streak);
+
+    // and it all comes back from the file
+    daily_history_open(&history, "test.dat", 5);
+    TEST_ASSERT_EQUAL_UINT32(100, history.first_day);
+    TEST_ASSERT_EQUAL_UINT32(6, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(21, history.last.sum);
+}
+
+static void test_truncate_on_clock_back(void) {
+    for (uint32_t day = 100; day < 106; day++) TEST_ASSERT_TRUE(daily_history_append(&history, day, day - 90));
+
+    // the clock went back to day 102: it and the days after it are dropped, and the new value replaces it
+    TEST_ASSERT_TRUE(daily_history_append(&history, 102, 1));
+    TEST_ASSERT_EQUAL_UINT32(100, history.first_day);
+    TEST_ASSERT_EQUAL_UINT32(3, history.num_days);
+    TEST_ASSERT_EQUAL_UINT16(11, daily_history_get_value(&history, 101));
+    TEST_ASSERT_EQUAL_UINT16(1, daily_history_get_value(&history, 102));
+    TEST_ASSERT_EQUAL_UINT16(0, daily_history_get_value(&history, 103));
+    TEST_ASSERT_EQUAL_UINT32(22, history.last.sum);
+    TEST_ASSERT_EQUAL_UINT16(0, history.last.streak);
+
+    daily_history_open(&history, "test.dat", 5);
+    TEST_ASSERT_EQUAL_UINT32(3, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(22, history.last.sum);
+}
+
+static void test_restart(void) {
+    TEST_ASSERT_TRUE(daily_history_append(&history, 100, 6));
+
+    // a day before the log starts it over
+    TEST_ASSERT_TRUE(daily_history_append(&history, 50, 3));
+    TEST_ASSERT_EQUAL_UINT32(50, history.first_day);
+    TEST_ASSERT_EQUAL_UINT32(1, history.num_days);
+
+    // a gap of a year is filled in...
+    TEST_ASSERT_TRUE(daily_history_append(&history, 51 + MAX_GAP_DAYS, 2));
+    TEST_ASSERT_EQUAL_UINT32(50, history.first_day);
+    TEST_ASSERT_EQUAL_UINT32(MAX_GAP_DAYS + 2, history.num_days);
+
+    // ...but one day more starts the log over
+    uint32_t next_day = history.first_day + history.num_days;
+    TEST_ASSERT_TRUE(daily_history_append(&history, next_day + MAX_GAP_DAYS + 1, 4));
+    TEST_ASSERT_EQUAL_UINT32(next_day + MAX_GAP_DAYS + 1, history.first_day);
+    TEST_ASSERT_EQUAL_UINT32(1, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(4, history.last.sum);
+    TEST_ASSERT_EQUAL_INT32(4 + 8, fake_size);
+}
+
+static void test_stats_clipping(void) {
+    daily_history_stats_t stats;
+
+    TEST_ASSERT_FALSE(daily_history_get_stats(&history, 0, 1000, &stats));
+
+    for (uint32_t day = 100; day < 110; day++) TEST_ASSERT_TRUE(daily_history_append(&history, day, 5));
+
+    // a range wider than the log is clipped to it
+    TEST_ASSERT_TRUE(daily_history_get_stats(&history, 0, 1000, &stats));
+    TEST_ASSERT_EQUAL_UINT32(50, stats.total);
+    TEST_ASSERT_EQUAL_UINT16(10, stats.num_days);
+    // the range ends after the log, so there's no streak as of its last day
+    TEST_ASSERT_EQUAL_UINT16(0, stats.streak);
+    TEST_ASSERT_EQUAL_UINT16(10, stats.best_streak);
+
+    // a range inside the log
+    TEST_ASSERT_TRUE(daily_history_get_stats(&history, 103, 105, &stats));
+    TEST_ASSERT_EQUAL_UINT32(15, stats.total);
+    TEST_ASSERT_EQUAL_UINT16(3, stats.num_days);
+    TEST_ASSERT_EQUAL_UINT16(6, stats.streak);
+    TEST_ASSERT_EQUAL_UINT16(6, stats.best_streak);
+
+    // ranges entirely outside it, or backwards
+    TEST_ASSERT_FALSE(daily_history_get_stats(&history, 0, 99, &stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.total);
+    TEST_ASSERT_FALSE(daily_history_get_stats(&history, 110, 120, &stats));
+    TEST_ASSERT_FALSE(daily_history_get_stats(&history, 105, 104, &stats));
+}
+
+static void test_rotate_at_size_cap(void) {
+    // a long streak early on, then days that don't count
+    for (uint32_t day = 0; day < MAX_DAYS; day++) {
+        TEST_ASSERT_TRUE(daily_history_append(&history, 1000 + day, day < 20 ? 5 : 1));
+    }
+    TEST_ASSERT_EQUAL_UINT32(MAX_DAYS, history.num_days);
+
+    TEST_ASSERT_TRUE(daily_history_append(&history, 1000 + MAX_DAYS, 9));
+    TEST_ASSERT_EQUAL_UINT32(KEEP_DAYS + 1, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(1000 + MAX_DAYS - KEEP_DAYS, history.first_day);
+    TEST_ASSERT_EQUAL_INT32(4 + (KEEP_DAYS + 1) * 8, fake_size);
+
+    // values survive the rebase, and the best streak still remembers the dropped days
+    TEST_ASSERT_EQUAL_UINT16(1, daily_history_get_value(&history, history.first_day));
+    TEST_ASSERT_EQUAL_UINT16(9, daily_history_get_value(&history, 1000 + MAX_DAYS));
+    daily_history_stats_t stats;
+    TEST_ASSERT_TRUE(daily_history_get_stats(&history, 0, 1000 + MAX_DAYS, &stats));
+    TEST_ASSERT_EQUAL_UINT32(KEEP_DAYS + 9, stats.total);
+    TEST_ASSERT_EQUAL_UINT16(20, stats.best_streak);
+
+    daily_history_open(&history, "test.dat", 5);
+    TEST_ASSERT_EQUAL_UINT32(KEEP_DAYS + 1, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(KEEP_DAYS + 9, history.last.sum);
+}
+
+static void test_rotate_when_full(void) {
+    // room for the header and 20 records
+    fake_capacity = 4 + 20 * 8;
+    for (uint32_t day = 0; day < 20; day++) TEST_ASSERT_TRUE(daily_history_append(&history, 500 + day, day + 1));
+
+    // the next append fails, so the older half goes
+    TEST_ASSERT_TRUE(daily_history_append(&history, 520, 50));
+    TEST_ASSERT_EQUAL_UINT32(11, history.num_days);
+    TEST_ASSERT_EQUAL_UINT32(510, history.first_day);
+    TEST_ASSERT_EQUAL_UINT16(11, daily_history_get_value(&history, 510));
+    TEST_ASSERT_EQUAL_UINT16(50, daily_history_get_value(&history, 520));
+    TEST_ASSERT_EQUAL_UINT16(17, history.last.best_streak);
+
+    // a gap that can't fit even then is refused; the latest days are still there
+    TEST_ASSERT_FALSE(daily_history_append(&history, 540, 1));
+    TEST_ASSERT_EQUAL_UINT32(520, history.first_day + history.num_days - 1);
+    TEST_ASSERT_EQUAL_UINT16(50, daily_history_get_value(&history, 520));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_gap_fill);
+  RUN_TEST(test_truncate_on_clock_back);
+  RUN_TEST(test_restart);
+  RUN_TEST(test_stats_clipping);
+  RUN_TEST(test_rotate_at_size_cap);
+  RUN_TEST(test_rotate_when_full);
+  return UNITY_END();
+}
@@ -0,0 +1,5 @@
+// Stands in for the watch library, which filesystem.h includes but daily_history.c doesn't use.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
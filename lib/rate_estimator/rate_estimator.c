@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "rate_estimator.h"
+
+static uint32_t _rate_estimator_median(const rate_estimator_t *est) {
+    uint32_t sorted[RATE_ESTIMATOR_WINDOW];
+
+    // insertion sort; the window is tiny
+    for (uint8_t i = 0; i < est->count; i++) {
+        uint32_t value = est->intervals[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    return sorted[est->count / 2];
+}
+
+void rate_estimator_reset(rate_estimator_t *est) {
+    memset(est, 0, sizeof(rate_estimator_t));
+}
+
+bool rate_estimator_add(rate_estimator_t *est, uint32_t counter) {
+    uint32_t interval = counter - est->last;
+    bool had_last = est->has_last;
+
+    est->last = counter;
+    est->has_last = true;
+    if (!had_last || interval == 0) return had_last;
+
+    if (est->count >= RATE_ESTIMATOR_MIN_FOR_REJECTION) {
+        uint32_t median = _rate_estimator_median(est);
+        uint32_t tolerance = median / 4;
+        if (interval + tolerance < median || interval > median + tolerance) {
+            if (++est->outliers < RATE_ESTIMATOR_MAX_OUTLIERS) return false;
+            est->count = 0;
+            est->head = 0;
+        }
+    }
+
+    est->outliers = 0;
+    est->intervals[est->head] = interval;
+    est->head = (est->head + 1) % RATE_ESTIMATOR_WINDOW;
+    if (est->count < RATE_ESTIMATOR_WINDOW) est->count++;
+
+    return true;
+}
+
+uint32_t rate_estimator_get_rate(const rate_estimator_t *est, uint32_t ticks_per_second) {
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < est->count; i++) sum += est->intervals[i];
+
+    return rate_estimator_rate_of(est->count, sum, ticks_per_second);
+}
+
+uint32_t rate_estimator_rate_of(uint32_t events, uint32_t ticks, uint32_t ticks_per_second) {
+    if (ticks == 0) return 0;
+
+    // 6000 hundredths of a minute per second; fits in 32 bits for up to ~5000 events at 128 Hz.
+    return (6000 * ticks_per_second * events + ticks / 2) / ticks;
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RATE_ESTIMATOR_H_
+#define RATE_ESTIMATOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Integer rate estimation from event timestamps, such as button presses or
+ * accelerometer taps in time with a pulse.
+ *
+ * Each event is given as a raw RTC counter value, so the resolution is that
+ * of the counter rather than of any tick rate. The rate is the mean of the
+ * last RATE_ESTIMATOR_WINDOW intervals. Once there are a few of them, an
+ * interval more than a quarter away from their median is dropped as a
+ * missed or doubled event; RATE_ESTIMATOR_MAX_OUTLIERS of those in a row are
+ * taken to mean that the rate itself has changed, and the window starts over.
+ */
+
+#define RATE_ESTIMATOR_WINDOW 8
+#define RATE_ESTIMATOR_MIN_FOR_REJECTION 3
+#define RATE_ESTIMATOR_MAX_OUTLIERS 3
+
+typedef struct {
+    uint32_t intervals[RATE_ESTIMATOR_WINDOW];  // accepted intervals, in counter ticks
+    uint32_t last;                              // counter value of the last event
+    uint8_t head;                               // where the next interval goes
+    uint8_t count;                              // accepted intervals in the window
+    uint8_t outliers;                           // intervals dropped in a row
+    bool has_last;
+} rate_estimator_t;
+
+void rate_estimator_reset(rate_estimator_t *est);
+
+/** @brief Adds an event.
+  * @param counter The RTC counter value when the event happened.
+  * @return false if the interval since the previous event was dropped as an outlier.
+  */
+bool rate_estimator_add(rate_estimator_t *est, uint32_t counter);
+
+/** @brief The estimated rate, in hundredths of events per minute, or 0 if there is no interval yet.
+  * @param ticks_per_second The frequency of the counter passed to rate_estimator_add.
+  */
+uint32_t rate_estimator_get_rate(const rate_estimator_t *est, uint32_t ticks_per_second);
+
+/** @brief The rate of a number of events spread over a span of counter ticks, in hundredths of events per minute.
+  */
+uint32_t rate_estimator_rate_of(uint32_t events, uint32_t ticks, uint32_t ticks_per_second);
+
+#endif // RATE_ESTIMATOR_H_
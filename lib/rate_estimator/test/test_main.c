@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build and run from this directory:
+//   cc -I.. test_main.c unity.c ../rate_estimator.c -o test_rate_estimator && ./test_rate_estimator
+
+#include <stdint.h>
+#include "rate_estimator.h"
+#include "unity.h"
+
+#define TICKS_PER_SECOND 128
+
+static rate_estimator_t est;
+
+// The counter value of beat n at a rate in hundredths per minute, starting at 1000; rounded like an RTC would.
+static uint32_t beat(uint32_t n, uint32_t rate) {
+    return 1000 + (uint32_t)(((uint64_t)n * 6000 * TICKS_PER_SECOND * 100 / rate + 50) / 100);
+}
+
+void setUp(void) {
+    rate_estimator_reset(&est);
+}
+
+void tearDown(void) {
+}
+
+void test_no_rate_before_two_events(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+void test_steady_taps(void) {
+    // 72 per minute is 106.67 ticks apart, so the intervals alternate between 106 and 107.
+    for (uint32_t n = 0; n < 20; n++) {
+        bool accepted = rate_estimator_add(&est, beat(n, 7200));
+        if (n) TEST_ASSERT_TRUE(accepted);
+    }
+    TEST_ASSERT_UINT32_WITHIN(50, 7200, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+void test_steady_taps_across_counter_wrap(void) {
+    uint32_t start = UINT32_MAX - 300;
+    for (uint32_t n = 0; n < 12; n++) rate_estimator_add(&est, start + n * 128);
+    TEST_ASSERT_EQUAL_UINT32(6000, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+void test_one_outlier_is_dropped(void) {
+    for (uint32_t n = 0; n < 8; n++) rate_estimator_add(&est, beat(n, 6000));
+    uint32_t before = rate_estimator_get_rate(&est, TICKS_PER_SECOND);
+
+    // a tap far off the beat: the intervals to it and from it are both outliers.
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, beat(8, 6000) - 50));
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, beat(9, 6000)));
+    TEST_ASSERT_EQUAL_UINT32(before, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+
+    // and the taps after that count again.
+    TEST_ASSERT_TRUE(rate_estimator_add(&est, beat(10, 6000)));
+    TEST_ASSERT_EQUAL_UINT32(6000, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+void test_missed_tap_is_dropped(void) {
+    for (uint32_t n = 0; n < 6; n++) rate_estimator_add(&est, beat(n, 9000));
+    uint32_t before = rate_estimator_get_rate(&est, TICKS_PER_SECOND);
+
+    // beat 6 never arrives, so the next interval is twice as long.
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, beat(7, 9000)));
+    TEST_ASSERT_EQUAL_UINT32(before, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+
+    TEST_ASSERT_TRUE(rate_estimator_add(&est, beat(8, 9000)));
+    TEST_ASSERT_UINT32_WITHIN(60, 9000, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+void test_new_rate_takes_over(void) {
+    for (uint32_t n = 0; n < 8; n++) rate_estimator_add(&est, beat(n, 6000));
+
+    // from 60 to 120 per minute: a couple of intervals are dropped before the window starts over.
+    uint32_t start = beat(7, 6000);
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, start + 64));
+    TEST_ASSERT_FALSE(rate_estimator_add(&est, start + 128));
+    TEST_ASSERT_TRUE(rate_estimator_add(&est, start + 192));
+    TEST_ASSERT_EQUAL_UINT32(12000, rate_estimator_get_rate(&est, TICKS_PER_SECOND));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_rate_before_two_events);
+    RUN_TEST(test_steady_taps);
+    RUN_TEST(test_steady_taps_across_counter_wrap);
+    RUN_TEST(test_one_outlier_is_dropped);
+    RUN_TEST(test_missed_tap_is_dropped);
+    RUN_TEST(test_new_rate_takes_over);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "spectrum.h"
+
+// cos(2πk/32) and sin(2πk/32) in Q15, for k from 0 to 15.
+static const int16_t _spectrum_cos[SPECTRUM_SIZE / 2] = {
+    32767, 32137, 30273, 27245, 23170, 18204, 12539, 6393,
+    0, -6393, -12539, -18204, -23170, -27245, -30273, -32137,
+};
+static const int16_t _spectrum_sin[SPECTRUM_SIZE / 2] = {
+    0, 6393, 12539, 18204, 23170, 27245, 30273, 32137,
+    32767, 32137, 30273, 27245, 23170, 18204, 12539, 6393,
+};
+
+// Periodic Hann window in Q15; its coherent gain is one half.
+static const int16_t _spectrum_hann[SPECTRUM_SIZE] = {
+    0, 315, 1247, 2761, 4799, 7281, 10114, 13187,
+    16383, 19580, 22653, 25486, 27968, 30006, 31520, 32452,
+    32767, 32452, 31520, 30006, 27968, 25486, 22653, 19580,
+    16384, 13187, 10114, 7281, 4799, 2761, 1247, 315,
+};
+
+static const uint8_t _spectrum_bit_reverse[SPECTRUM_SIZE] = {
+    0, 16, 8, 24, 4, 20, 12, 28, 2, 18, 10, 26, 6, 22, 14, 30,
+    1, 17, 9, 25, 5, 21, 13, 29, 3, 19, 11, 27, 7, 23, 15, 31,
+};
+
+static uint16_t _spectrum_isqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+void spectrum_fft_q15(int16_t re[SPECTRUM_SIZE], int16_t im[SPECTRUM_SIZE]) {
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        uint8_t j = _spectrum_bit_reverse[i];
+        if (j > i) {
+            int16_t temp = re[i]; re[i] = re[j]; re[j] = temp;
+            temp = im[i]; im[i] = im[j]; im[j] = temp;
+        }
+    }
+
+    // decimation in time; halving at every stage keeps each butterfly within 16 bits.
+    for (uint8_t half = 1, step = SPECTRUM_SIZE / 2; half < SPECTRUM_SIZE; half <<= 1, step >>= 1) {
+        for (uint8_t k = 0; k < half; k++) {
+            int32_t wr = _spectrum_cos[k * step];
+            int32_t wi = -_spectrum_sin[k * step];
+            for (uint8_t i = k; i < SPECTRUM_SIZE; i += half * 2) {
+                uint8_t j = i + half;
+                int32_t tr = (wr * re[j] - wi * im[j]) >> 15;
+                int32_t ti = (wr * im[j] + wi * re[j]) >> 15;
+                re[j] = (re[i] - tr) >> 1;
+                im[j] = (im[i] - ti) >> 1;
+                re[i] = (re[i] + tr) >> 1;
+                im[i] = (im[i] + ti) >> 1;
+            }
+        }
+    }
+}
+
+bool spectrum_find_peak(const int16_t samples[SPECTRUM_SIZE], uint32_t sample_rate_mhz, spectrum_peak_t *peak) {
+    int16_t re[SPECTRUM_SIZE];
+    int16_t im[SPECTRUM_SIZE] = {0};
+    uint16_t magnitude[SPECTRUM_SIZE / 2 + 1];
+    int32_t sum = 0;
+    int32_t max = 0;
+
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) sum += samples[i];
+    int32_t mean = sum / SPECTRUM_SIZE;
+
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        int32_t value = abs(samples[i] - mean);
+        if (value > max) max = value;
+    }
+    if (max == 0) return false;
+
+    // scale the block up as far as it goes so small vibrations keep their precision through the FFT.
+    uint8_t shift = 0;
+    while ((max << (shift + 1)) < 16384) shift++;
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        int32_t value = (samples[i] - mean) * (1L << shift);
+        if (value > INT16_MAX) value = INT16_MAX;
+        if (value < INT16_MIN) value = INT16_MIN;
+        re[i] = (value * _spectrum_hann[i]) >> 15;
+    }
+
+    spectrum_fft_q15(re, im);
+
+    uint8_t bin = 1;
+    for (uint8_t i = 0; i <= SPECTRUM_SIZE / 2; i++) {
+        magnitude[i] = _spectrum_isqrt((int32_t)re[i] * re[i] + (int32_t)im[i] * im[i]);
+        if (i >= 1 && i < SPECTRUM_SIZE / 2 && magnitude[i] > magnitude[bin]) bin = i;
+    }
+    if (magnitude[bin] == 0) return false;
+
+    // for a Hann window, the offset from the bin centre is 2(c - a) / (a + 2b + c), exact for a pure tone.
+    int32_t a = magnitude[bin - 1];
+    int32_t b = magnitude[bin];
+    int32_t c = magnitude[bin + 1];
+    int32_t offset_milli;
+    if (bin == 1) {
+        // DC and Nyquist also pick up the tone's mirror image, so next to them, go by the other neighbour alone:
+        // c / b is (1 + d) / (2 - d) for an offset d.
+        offset_milli = 1000 * (2 * c - b) / (b + c);
+    } else if (bin == SPECTRUM_SIZE / 2 - 1) {
+        offset_milli = 1000 * (b - 2 * a) / (a + b);
+    } else {
+        offset_milli = 2000 * (c - a) / (a + 2 * b + c);
+    }
+    int32_t bin_milli = bin * 1000 + offset_milli;
+
+    peak->bin = bin;
+    // sample_rate_mhz / 8 is exact for every LIS2DW rate and keeps the product within 32 bits.
+    peak->frequency_mhz = (uint32_t)bin_milli * (sample_rate_mhz / 8) / (SPECTRUM_SIZE / 8 * 1000);
+    // scaled by 1 / SPECTRUM_SIZE in the FFT, a tone of amplitude A shows up as A / 2 × 1 / 2 for the window.
+    peak->amplitude = ((uint32_t)b * 4 + (1UL << shift >> 1)) >> shift;
+
+    return true;
+}
@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Fixed-point spectrum analysis for blocks of accelerometer samples.
+ *
+ * Everything here is integer-only: a radix-2 FFT in Q15 with one bit of
+ * scaling per stage, so it cannot overflow, and an integer square root for
+ * the magnitudes. A 32-sample block is sized to match one full LIS2DW FIFO.
+ */
+
+#define SPECTRUM_SIZE 32
+#define SPECTRUM_LOG2_SIZE 5
+
+typedef struct {
+    uint8_t bin;            // strongest bin, 1 to SPECTRUM_SIZE / 2 - 1 (DC and Nyquist are skipped)
+    uint32_t frequency_mhz; // interpolated frequency of that bin, in millihertz
+    uint16_t amplitude;     // peak amplitude at that bin, in the units of the input samples
+} spectrum_peak_t;
+
+/** @brief In-place forward FFT of SPECTRUM_SIZE complex Q15 values.
+  * @details The result is scaled by 1 / SPECTRUM_SIZE, so any input fits without overflow.
+  * @param re The real parts, replaced with the real parts of the spectrum.
+  * @param im The imaginary parts, replaced with the imaginary parts of the spectrum.
+  */
+void spectrum_fft_q15(int16_t re[SPECTRUM_SIZE], int16_t im[SPECTRUM_SIZE]);
+
+/** @brief Finds the dominant frequency in a block of samples.
+  * @details The block has its mean removed, is scaled up to use the full Q15 range, gets a Hann
+  *          window and goes through spectrum_fft_q15. The frequency is refined between bins using
+  *          the magnitudes of the two neighbouring bins.
+  * @param samples SPECTRUM_SIZE samples, oldest first.
+  * @param sample_rate_mhz The rate the samples were taken at, in millihertz.
+  * @param peak Filled in with the strongest bin, if there is one.
+  * @return false if the block is flat, in which case peak is left alone.
+  */
+bool spectrum_find_peak(const int16_t samples[SPECTRUM_SIZE], uint32_t sample_rate_mhz, spectrum_peak_t *peak);
+
+#endif // SPECTRUM_H_
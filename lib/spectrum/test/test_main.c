@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build and run from this directory:
+//   cc -I.. test_main.c unity.c ../spectrum.c -lm -o test_spectrum && ./test_spectrum
+
+#include <math.h>
+#include <stdint.h>
+#include "spectrum.h"
+#include "unity.h"
+
+// 100 Hz, one of the LIS2DW rates; a bin is 3.125 Hz wide.
+#define RATE_MHZ 100000
+
+static int16_t samples[SPECTRUM_SIZE];
+
+// Fills the block with a tone of the given frequency and amplitude on top of an offset, the way gravity sits
+// under a vibration on one axis.
+static void make_tone(uint32_t frequency_mhz, int16_t amplitude, int16_t offset) {
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        double phase = 2 * M_PI * frequency_mhz * i / RATE_MHZ;
+        samples[i] = offset + (int16_t)lround(amplitude * sin(phase + 0.3));
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_flat_block_has_no_peak(void) {
+    spectrum_peak_t peak = { .bin = 99 };
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) samples[i] = 1000;
+    TEST_ASSERT_FALSE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(99, peak.bin);
+}
+
+void test_tone_on_bin_centres(void) {
+    spectrum_peak_t peak;
+    for (uint8_t bin = 1; bin < SPECTRUM_SIZE / 2; bin++) {
+        uint32_t frequency_mhz = bin * RATE_MHZ / SPECTRUM_SIZE;
+        make_tone(frequency_mhz, 4000, 0);
+        TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+        TEST_ASSERT_EQUAL_UINT8(bin, peak.bin);
+        TEST_ASSERT_UINT32_WITHIN(20, frequency_mhz, peak.frequency_mhz);
+        TEST_ASSERT_UINT16_WITHIN(40, 4000, peak.amplitude);
+    }
+}
+
+void test_tone_between_bins(void) {
+    spectrum_peak_t peak;
+    // 10 Hz is bin 3.2, 22.5 Hz is bin 7.2 and 40.6 Hz is bin 12.99.
+    make_tone(10000, 2000, 0);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(3, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(150, 10000, peak.frequency_mhz);
+
+    make_tone(22500, 2000, 0);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(7, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(150, 22500, peak.frequency_mhz);
+
+    make_tone(40600, 2000, 0);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(13, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(150, 40600, peak.frequency_mhz);
+
+    // next to DC and Nyquist, where the mirror image leaks into the outer neighbour: bins 1.28 and 14.72.
+    make_tone(4000, 2000, 0);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(1, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(300, 4000, peak.frequency_mhz);
+
+    make_tone(46000, 2000, 0);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(15, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(300, 46000, peak.frequency_mhz);
+}
+
+void test_offset_is_ignored(void) {
+    spectrum_peak_t peak;
+    // a 1 g offset in the LIS2DW's ±2 g scale, under a small 12.5 Hz vibration.
+    make_tone(12500, 300, 16384);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(4, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(20, 12500, peak.frequency_mhz);
+    TEST_ASSERT_UINT16_WITHIN(10, 300, peak.amplitude);
+}
+
+void test_small_tone_keeps_its_bin(void) {
+    spectrum_peak_t peak;
+    // a few counts is all a light vibration gives; the block is scaled up before the FFT.
+    make_tone(25000, 8, -200);
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(8, peak.bin);
+    TEST_ASSERT_UINT32_WITHIN(200, 25000, peak.frequency_mhz);
+}
+
+void test_stronger_tone_wins(void) {
+    spectrum_peak_t peak;
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        samples[i] = (int16_t)lround(3000 * sin(2 * M_PI * 6 * i / SPECTRUM_SIZE) +
+                                     1000 * sin(2 * M_PI * 11 * i / SPECTRUM_SIZE));
+    }
+    TEST_ASSERT_TRUE(spectrum_find_peak(samples, RATE_MHZ, &peak));
+    TEST_ASSERT_EQUAL_UINT8(6, peak.bin);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_flat_block_has_no_peak);
+    RUN_TEST(test_tone_on_bin_centres);
+    RUN_TEST(test_tone_between_bins);
+    RUN_TEST(test_offset_is_ignored);
+    RUN_TEST(test_small_tone_keeps_its_bin);
+    RUN_TEST(test_stronger_tone_wins);
+    return UNITY_END();
+}
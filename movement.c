@@ -45,6 +45,7 @@
 #include "evsys.h"
 #include "delay.h"
 #include "thermistor_driver.h"
+#include "opt3001.h"
 
 #include "movement_config.h"
 
@@ -60,6 +61,86 @@ void _wake_up_simulator(void);
 volatile movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
 watch_date_time_t scheduled_tasks[MOVEMENT_NUM_FACES];
+
+#ifndef MOVEMENT_NUM_TIMERS
+#define MOVEMENT_NUM_TIMERS 8
+#endif
+
+#ifndef MOVEMENT_NUM_PERSISTENT_TIMERS
+#define MOVEMENT_NUM_PERSISTENT_TIMERS 2
+#endif
+
+#if MOVEMENT_NUM_PERSISTENT_TIMERS > MOVEMENT_NUM_TIMERS
+#error "MOVEMENT_NUM_PERSISTENT_TIMERS cannot exceed MOVEMENT_NUM_TIMERS"
+#endif
+
+#ifndef MOVEMENT_NUM_JOBS
+#define MOVEMENT_NUM_JOBS 4
+#endif
+
+// How long the job executor keeps calling steps before it lets the app loop handle events again.
+#ifndef MOVEMENT_JOB_SLICE_MS
+#define MOVEMENT_JOB_SLICE_MS 20
+#endif
+
+// Performance bursts are refused below this battery voltage, in millivolts.
+#ifndef MOVEMENT_BURST_MIN_VOLTAGE
+#define MOVEMENT_BURST_MIN_VOLTAGE 2500
+#endif
+
+// Typical current draw at PL2 and 16 MHz, in microamps, used to estimate the energy of each burst.
+#ifndef MOVEMENT_BURST_CURRENT_UA
+#define MOVEMENT_BURST_CURRENT_UA 1000
+#endif
+
+// Scheduled signals (the hourly chime, reminders) stay silent from the start hour up to the end hour, local time.
+// The window may wrap past midnight; equal hours mean no quiet hours.
+#ifndef MOVEMENT_QUIET_HOURS_START
+#define MOVEMENT_QUIET_HOURS_START 0
+#endif
+
+#ifndef MOVEMENT_QUIET_HOURS_END
+#define MOVEMENT_QUIET_HOURS_END 0
+#endif
+
+// The OPT3001's INT line is open drain, active low, and expected on A2, which can also wake us from low energy mode.
+#define MOVEMENT_OPT3001_ADDRESS 0x44
+
+// Window of each light band, in centilux. Neighbouring windows overlap, so a band is only left once the light is
+// well into the next one.
+static const uint32_t _movement_light_band_low[] = { 0, 800, 160000 };
+static const uint32_t _movement_light_band_high[] = { 1200, 250000, UINT32_MAX };
+
+typedef struct {
+    movement_light_band_t band;
+    uint32_t centilux;
+    uint32_t subscribers;               // bit n set if face n wants EVENT_LIGHT_BAND_CHANGED
+    uint32_t num_interrupts;            // for the light shell command
+    uint32_t num_changes;
+    rtc_counter_t start_counter;
+} movement_light_state_t;
+
+static movement_light_state_t _movement_light = { .band = MOVEMENT_LIGHT_BAND_INDOOR };
+
+// Timer ids are 3 bits wide so that a persisted timer fits in one backup register.
+#define MOVEMENT_NUM_TIMER_IDS 8
+
+// A persisted timer keeps the low 24 bits of its target in bits 31-8 of its backup register, which is unambiguous
+// for targets up to this far from now (minus the grace period below). Bits 7-3 hold the face index plus one, so that
+// a register in use is never zero, and bits 2-0 hold the timer id.
+#define MOVEMENT_TIMER_BACKUP_WINDOW (1UL << 24)
+// When restoring, targets up to this many seconds in the past are taken to have expired during the reset.
+#define MOVEMENT_TIMER_BACKUP_GRACE 86400
+
+typedef struct {
+    uint32_t target;            // UTC timestamp; 0 when the slot is free
+    uint8_t watch_face_index;
+    uint8_t timer_id;
+} movement_timer_t;
+
+static movement_timer_t _movement_timers[MOVEMENT_NUM_TIMERS];
+// backup register mirroring each of the first timer slots, or 0 if none could be claimed
+static uint8_t _movement_timer_backup_registers[MOVEMENT_NUM_PERSISTENT_TIMERS];
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
 
@@ -74,9 +155,19 @@ typedef struct {
     movement_timeout_index_t timeout_index;
     volatile bool is_down;
     volatile rtc_counter_t down_timestamp;
-#if MOVEMENT_DEBOUNCE_TICKS
     volatile rtc_counter_t up_timestamp;
-#endif
+    // the same edges in 1/WATCH_CAPTURE_HZ seconds, see movement_enable_button_capture
+    volatile uint32_t down_capture;
+    volatile uint32_t up_capture;
+    volatile bool is_captured;
+    volatile bool is_injected;  // held down from the shell, see movement_cmd_btn
+    uint8_t pin;
+    // with MOVEMENT_DEBOUNCE_TICKS, the button's interrupt is masked from each edge until the contacts have settled
+    volatile bool is_settling;
+    volatile rtc_counter_t settle_counter;
+    // for movement_cmd_buttons: interrupts taken, bounces and all, against the edges that became events
+    volatile uint32_t num_interrupts;
+    volatile uint32_t num_edges;
 } movement_button_t;
 
 /* Pieces of state that can be modified by the various interrupt callbacks.
@@ -92,10 +183,14 @@ typedef struct {
     volatile uint8_t subsecond;
     volatile rtc_counter_t minute_counter;
     volatile bool minute_alarm_fired;
+    volatile bool timer_fired;
     volatile bool is_buzzing;
     volatile uint8_t pending_sequence_priority;
     volatile bool schedule_next_comp;
     volatile bool has_pending_accelerometer;
+    volatile rtc_counter_t accelerometer_counter;   // when the accelerometer interrupt that's pending fired
+    volatile bool has_pending_light;
+    volatile uint16_t injected_ticks;
 
     // button tracking for long press
     movement_button_t mode_button;
@@ -104,10 +199,211 @@ typedef struct {
 
     // button events that will not be passed to the current face loop, but will instead passed directly to the default loop handler.
     volatile uint32_t passthrough_events;
+
+    // display animation, advanced from the ANIMATION_TIMEOUT comp callback
+    const movement_animation_t * volatile animation;
+    volatile uint8_t animation_frame;
+    volatile rtc_counter_t animation_counter;
+    volatile uint32_t animation_frame_ticks;
+
+    // beat engine, advanced from the BEAT_TIMEOUT comp callback
+    const movement_beat_pattern_t * volatile beat_pattern;
+    volatile rtc_counter_t beat_counter;        // deadline of the next beat
+    volatile uint32_t beat_period_ticks;        // whole RTC ticks in a beat period
+    volatile uint32_t beat_period_remainder;    // and the rest of it, in 1/centibeats_per_minute ticks
+    volatile uint32_t beat_error;               // remainder carried over so far, in the same units
+    volatile uint8_t beat_index;                // position of the next beat in the pattern
+    volatile uint8_t beat_step;                 // step that the next beat belongs to
+    volatile uint8_t beat_step_beat;            // and how far into that step it is
+    volatile uint8_t beat_fired_index;          // position of the last beat played
+    volatile bool beat_fired;
+    const movement_beat_step_t * volatile beat_cue; // step whose cues are due, played from app_loop
+    volatile rtc_counter_t beat_cue_counter;    // deadline of the beat they belong to
+
+    // the foreground face's coroutine wants EVENT_COROUTINE_RESUME when the buzzer stops
+    volatile bool coroutine_wants_buzzer;
+
+    // the REDRAW_TIMEOUT comp callback has come, so the foreground face's displayed value may have changed
+    volatile bool redraw_due;
 } movement_volatile_state_t;
 
+// pending_events holds one bit per event type.
+_Static_assert(EVENT_NUM_EVENTS <= 32, "movement_event_type_t has outgrown the pending_events mask");
+
 movement_volatile_state_t movement_volatile_state;
 
+// RTC counters recorded for the app_loop passes that handle events injected from the shell,
+// so that a host script can measure the latency and active time of each face.
+typedef struct {
+    rtc_counter_t injected_counter;     // when the last event was injected
+    rtc_counter_t handled_counter;      // when the app_loop pass that handled it finished
+    uint32_t active_ticks;              // total ticks spent in app_loop passes handling injected events
+    uint32_t num_loops;                 // number of such passes
+    bool pending;
+} movement_injection_stats_t;
+
+static movement_injection_stats_t _movement_injection_stats;
+
+// How well the beat engine has kept time since it was last started, for the beats shell command.
+typedef struct {
+    rtc_counter_t start_counter;        // deadline of the first beat
+    uint32_t num_beats;                 // beats played
+    uint32_t max_late_ticks;            // worst delay between a deadline and its callback
+} movement_beat_stats_t;
+
+static movement_beat_stats_t _movement_beat_stats;
+
+#define MOVEMENT_NUM_JOB_IDS 8
+
+typedef struct {
+    movement_job_step_t step;   // NULL when the slot is free
+    void *context;
+    rtc_counter_t deadline;
+    uint8_t watch_face_index;
+    uint8_t job_id;
+} movement_job_t;
+
+static movement_job_t _movement_jobs[MOVEMENT_NUM_JOBS];
+
+typedef struct {
+    uint8_t depth;                      // jobs queued right now
+    uint8_t max_depth;
+    uint32_t num_submitted;
+    uint32_t num_completed;
+    uint32_t num_late;                  // finished after their deadline
+    uint32_t num_slices;
+    uint32_t num_steps;
+    uint32_t num_overruns;              // slices that ran past their budget, because a single step took too long
+    uint32_t max_slice_ticks;
+} movement_job_stats_t;
+
+static movement_job_stats_t _movement_job_stats;
+
+#ifdef MOVEMENT_STACK_PROFILING
+// Deepest stack seen while a face's loop was running, in bytes, by face and by event type. Interrupts that fire
+// during the call are counted against it too.
+typedef struct {
+    uint32_t *low_water;                // lowest word of the stack found written to since boot
+    uint16_t face_bytes[MOVEMENT_NUM_FACES];
+    uint16_t event_bytes[EVENT_NUM_EVENTS];
+} movement_stack_stats_t;
+
+static movement_stack_stats_t _movement_stack;
+#endif
+
+// Cold boot. Before the first face draws, app_init and app_setup only do what it needs: the settings, the clock, the
+// display, the face on screen, and the sensor probes, which faces look for in their setup. The rest of the watch comes
+// up after that, one step per app_loop pass, with each step timed for movement_cmd_boot. A step returns true once it
+// is done, or false to be called again later; a step that is waiting arms BOOT_TIMEOUT for when it can go on.
+typedef enum {
+    MOVEMENT_BOOT_SENSORS = 0,
+    MOVEMENT_BOOT_THERMISTOR,
+    MOVEMENT_BOOT_FACES,                // the first step after the first draw
+    MOVEMENT_BOOT_FILESYSTEM,
+    MOVEMENT_BOOT_USB,
+    MOVEMENT_NUM_BOOT_STEPS
+} movement_boot_step_index_t;
+
+typedef struct {
+    const char *name;
+    bool (*run)(void);
+} movement_boot_step_t;
+
+typedef struct {
+    rtc_counter_t init_counter;         // when app_init began; the RTC can't see further back than that
+    rtc_counter_t first_pixel_counter;  // when the first face had handled EVENT_ACTIVATE
+    rtc_counter_t ready_counter;        // when the last step finished
+    rtc_counter_t vbus_counter;         // when the VBUS detect line was pulled down
+    uint32_t step_ticks[MOVEMENT_NUM_BOOT_STEPS];   // spent in each step, not counting passes in between
+    uint8_t step;                       // the next step to run
+    bool drawn;
+    bool faces_set_up;                  // all faces, not just the one on screen
+} movement_boot_t;
+
+static movement_boot_t _movement_boot;
+
+// Sets up the faces that app_setup left for after the first draw. Anything that reaches a face other than the one on
+// screen calls this first, so that no face sees an event before its setup.
+static void _movement_set_up_faces(void) {
+    if (_movement_boot.faces_set_up) return;
+    _movement_boot.faces_set_up = true;
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        if (i != movement_state.current_face_idx) watch_faces[i].setup(i, &watch_face_contexts[i]);
+    }
+}
+
+// The VBUS detect line has to sit on its pull-down for about 100 ms before it reads true.
+#define MOVEMENT_VBUS_SETTLE_TICKS 13
+
+#if !__EMSCRIPTEN__
+// bounds of the stack region, from the linker script
+extern uint32_t _sstack;
+extern uint32_t _estack;
+
+#define MOVEMENT_STACK_PAINT 0xA5A5A5A5
+// words just below the stack pointer that painting leaves alone, for the painting function's own frame
+#define MOVEMENT_STACK_PAINT_MARGIN 16
+
+static inline uint32_t *_movement_stack_pointer(void) {
+    uint32_t *sp;
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    return sp;
+}
+
+// Paints the unused stack from the given word up to just below the current stack pointer.
+static void __attribute__((noinline)) _movement_stack_paint(uint32_t *from) {
+    uint32_t *to = _movement_stack_pointer() - MOVEMENT_STACK_PAINT_MARGIN;
+    for (uint32_t *word = from; word < to; word++) *word = MOVEMENT_STACK_PAINT;
+}
+
+static uint32_t *_movement_stack_lowest_used(uint32_t *from) {
+    uint32_t *word = from;
+    while (word < &_estack && *word == MOVEMENT_STACK_PAINT) word++;
+    return word;
+}
+#endif
+
+// Every face loop call goes through here, so that Movement can tell how deep each face and event takes the stack.
+static bool _movement_face_loop(uint8_t watch_face_index, movement_event_t event) {
+#if __EMSCRIPTEN__ || !defined(MOVEMENT_STACK_PROFILING)
+    return watch_faces[watch_face_index].loop(event, watch_face_contexts[watch_face_index]);
+#else
+    // Repaint what earlier calls have used, so that this call's depth can be read back afterwards. That only
+    // touches the part of the stack that has been used at some point, not the whole of it.
+    uint32_t *low_water = _movement_stack.low_water;
+    _movement_stack_paint(low_water);
+
+    bool can_sleep = watch_faces[watch_face_index].loop(event, watch_face_contexts[watch_face_index]);
+
+    uint32_t *lowest = _movement_stack_lowest_used(low_water);
+    if (lowest == low_water) {
+        // this call may have gone past the old mark: look through the paint left from boot.
+        lowest = _movement_stack_lowest_used(&_sstack);
+        _movement_stack.low_water = lowest;
+    }
+
+    uint16_t bytes = (uint8_t *)&_estack - (uint8_t *)lowest;
+    if (bytes > _movement_stack.face_bytes[watch_face_index]) _movement_stack.face_bytes[watch_face_index] = bytes;
+    if (event.event_type < EVENT_NUM_EVENTS && bytes > _movement_stack.event_bytes[event.event_type]) {
+        _movement_stack.event_bytes[event.event_type] = bytes;
+    }
+
+    return can_sleep;
+#endif
+}
+
+typedef struct {
+    uint8_t depth;
+    bool is_fast;
+    rtc_counter_t start_counter;
+    uint16_t vcc;               // last battery reading in millivolts, 0 if none yet
+    uint32_t vcc_timestamp;
+    movement_burst_stats_t stats;
+} movement_burst_state_t;
+
+static movement_burst_state_t _movement_burst;
+
 // The last sequence that we have been asked to play while the watch was in deep sleep
 static int8_t *_pending_sequence;
 
@@ -131,8 +427,10 @@ int8_t _movement_dst_offset_cache[NUM_ZONE_NAMES] = {0};
 void cb_mode_btn_interrupt(void);
 void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
+void cb_button_settle(void);
 void cb_alarm_btn_extwake(void);
 void cb_minute_alarm_fired(void);
+void cb_timer_fired(void);
 void cb_tick(void);
 void cb_mode_btn_timeout_interrupt(void);
 void cb_light_btn_timeout_interrupt(void);
@@ -145,6 +443,16 @@ void cb_buzzer_stop(void);
 
 void cb_accelerometer_event(void);
 void cb_accelerometer_wake(void);
+void cb_animation_frame(void);
+void cb_beat(void);
+void cb_coroutine(void);
+void cb_redraw(void);
+void cb_light_sensor_interrupt(void);
+void cb_boot_step(void);
+
+#if !__EMSCRIPTEN__
+static void _movement_usb_idle(void);
+#endif
 
 #if __EMSCRIPTEN__
 void yield(void) {
@@ -286,12 +594,12 @@ static uint32_t _movement_get_accelerometer_events() {
 
     if (int_src & LIS2DW_REG_ALL_INT_SRC_DOUBLE_TAP) {
         accelerometer_events |= 1 << EVENT_DOUBLE_TAP;
-        printf("Double tap!\r\n");
+        WATCH_LOG_INFO("Double tap");
     }
 
     if (int_src & LIS2DW_REG_ALL_INT_SRC_SINGLE_TAP) {
         accelerometer_events |= 1 << EVENT_SINGLE_TAP;
-        printf("Single tap!\r\n");
+        WATCH_LOG_INFO("Single tap");
     }
 
     return accelerometer_events;
@@ -368,6 +676,8 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
 static void _movement_handle_top_of_minute(void) {
     watch_date_time_t date_time = watch_rtc_get_date_time();
 
+    _movement_set_up_faces();
+
     // update the DST offset cache every 30 minutes, since someplace in the world could change.
     if (date_time.unit.minute % 30 == 0) {
         _movement_update_dst_offset_cache();
@@ -383,7 +693,7 @@ static void _movement_handle_top_of_minute(void) {
             if (advisory.wants_background_task) {
                 // we give it one. pretty straightforward!
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
+                _movement_face_loop(i, background_event);
             }
 
             // TODO: handle other advisory types
@@ -400,7 +710,7 @@ static void _movement_handle_scheduled_tasks(void) {
             if (scheduled_tasks[i].reg <= date_time.reg) {
                 scheduled_tasks[i].reg = 0;
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
+                _movement_face_loop(i, background_event);
                 // check if loop scheduled a new task
                 if (scheduled_tasks[i].reg) {
                     num_active_tasks++;
@@ -418,14 +728,138 @@ static void _movement_handle_scheduled_tasks(void) {
     }
 }
 
+static rtc_counter_t _movement_counter_at_timestamp(uint32_t timestamp) {
+    rtc_counter_t counter = watch_rtc_get_counter();
+    uint32_t now = watch_rtc_get_unix_time();
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t half_freq = freq >> 1;
+    uint32_t subsecond_mask = freq - 1;
+
+    if (timestamp <= now) return counter + 1;
+
+    // the timestamp advances when the counter's subsecond bits reach half_freq, in sync with the 1 Hz tick.
+    rtc_counter_t next_second_counter = (counter & ~subsecond_mask) + half_freq;
+    if ((counter & subsecond_mask) >= half_freq) next_second_counter += freq;
+
+    // Keep the compare within half the counter's range. A target further out than that just gets re-armed
+    // when this one fires, since expiry is always judged by timestamp.
+    uint32_t seconds = timestamp - now - 1;
+    uint32_t max_seconds = (INT32_MAX / freq) - 1;
+    if (seconds > max_seconds) seconds = max_seconds;
+
+    return next_second_counter + seconds * freq;
+}
+
+static void _movement_schedule_next_timer(void) {
+    uint32_t soonest = 0;
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_TIMERS; i++) {
+        if (_movement_timers[i].target && (soonest == 0 || _movement_timers[i].target < soonest)) {
+            soonest = _movement_timers[i].target;
+        }
+    }
+
+    if (soonest) {
+        watch_rtc_register_comp_callback_no_schedule(cb_timer_fired, _movement_counter_at_timestamp(soonest), TIMER_TIMEOUT);
+    } else {
+        watch_rtc_disable_comp_callback_no_schedule(TIMER_TIMEOUT);
+    }
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+static void _movement_store_timer(uint8_t slot) {
+    if (slot >= MOVEMENT_NUM_PERSISTENT_TIMERS || _movement_timer_backup_registers[slot] == 0) return;
+
+    movement_timer_t *timer = &_movement_timers[slot];
+    uint32_t data = 0;
+
+    if (timer->target
+        && timer->watch_face_index < 31
+        && timer->target - watch_rtc_get_unix_time() < MOVEMENT_TIMER_BACKUP_WINDOW - MOVEMENT_TIMER_BACKUP_GRACE) {
+        data = (timer->target << 8) | ((timer->watch_face_index + 1) << 3) | timer->timer_id;
+    }
+
+    watch_store_backup_data(data, _movement_timer_backup_registers[slot]);
+}
+
+static void _movement_restore_timers(void) {
+    uint32_t now = watch_rtc_get_unix_time();
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_PERSISTENT_TIMERS; i++) {
+        _movement_timer_backup_registers[i] = movement_claim_backup_register();
+        if (_movement_timer_backup_registers[i] == 0) continue;
+
+        uint32_t data = watch_get_backup_data(_movement_timer_backup_registers[i]);
+        uint8_t watch_face_index = ((data >> 3) & 0x1F) - 1;
+        if (data == 0 || watch_face_index >= MOVEMENT_NUM_FACES) {
+            // either unused, or left over from a firmware with a different set of faces.
+            watch_store_backup_data(0, _movement_timer_backup_registers[i]);
+            continue;
+        }
+
+        // reconstruct the full target from its low 24 bits, as the nearest match to now.
+        uint32_t seconds_ahead = ((data >> 8) - now) & (MOVEMENT_TIMER_BACKUP_WINDOW - 1);
+        if (seconds_ahead >= MOVEMENT_TIMER_BACKUP_WINDOW - MOVEMENT_TIMER_BACKUP_GRACE) {
+            // expired while we were down; the comp callback will deliver it right away.
+            _movement_timers[i].target = now - (MOVEMENT_TIMER_BACKUP_WINDOW - seconds_ahead);
+        } else {
+            _movement_timers[i].target = now + seconds_ahead;
+        }
+        _movement_timers[i].watch_face_index = watch_face_index;
+        _movement_timers[i].timer_id = data & 0x7;
+    }
+
+    _movement_schedule_next_timer();
+}
+
+static void _movement_handle_expired_timers(void) {
+    uint32_t now = watch_rtc_get_unix_time();
+
+    // a timer restored at boot may belong to a face that hasn't been set up yet.
+    _movement_set_up_faces();
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_TIMERS; i++) {
+        movement_timer_t *timer = &_movement_timers[i];
+        if (timer->target == 0 || timer->target > now) continue;
+
+        // free the slot first, in case the face wants to start the timer again.
+        timer->target = 0;
+        _movement_store_timer(i);
+
+        uint8_t watch_face_index = timer->watch_face_index;
+        movement_event_t timer_event = { EVENT_TIMER_EXPIRED, timer->timer_id };
+        _movement_face_loop(watch_face_index, timer_event);
+    }
+
+    _movement_schedule_next_timer();
+}
+
+static movement_timer_t *_movement_find_timer(uint8_t watch_face_index, uint8_t timer_id) {
+    for (uint8_t i = 0; i < MOVEMENT_NUM_TIMERS; i++) {
+        movement_timer_t *timer = &_movement_timers[i];
+        if (timer->target && timer->watch_face_index == watch_face_index && timer->timer_id == timer_id) {
+            return timer;
+        }
+    }
+    return NULL;
+}
+
 void movement_request_tick_frequency(uint8_t freq) {
-    // Movement requires at least a 1 Hz tick.
     // If we are asked for an invalid frequency, default back to 1 Hz.
-    if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
+    if (freq != 0 && __builtin_popcount(freq) != 1) freq = 1;
 
     // disable all periodic callbacks
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 
+    if (freq == 0) {
+        // The face wants no ticks at all. Movement still checks scheduled background tasks on a 1 Hz tick, so it
+        // keeps one running while there are any, and doesn't pass it on.
+        movement_state.tick_frequency = 0;
+        movement_state.tick_pern = 7;
+        if (movement_state.has_scheduled_background_task) watch_rtc_register_tick_callback(cb_tick);
+        return;
+    }
+
     // this left-justifies the period in a 32-bit integer.
     uint32_t tmp = (freq & 0xFF) << 24;
     // now we can count the leading zeroes to get the value we need.
@@ -438,7 +872,243 @@ void movement_request_tick_frequency(uint8_t freq) {
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+static void _movement_show_animation_frame(const movement_animation_t *animation, uint8_t frame) {
+    uint32_t mask = animation->frames[frame];
+
+    for (uint8_t i = 0; i < animation->num_segments; i++) {
+        if (mask & (1UL << i)) {
+            watch_set_pixel(animation->segments[i].com, animation->segments[i].seg);
+        } else {
+            watch_clear_pixel(animation->segments[i].com, animation->segments[i].seg);
+        }
+    }
+}
+
+void movement_play_animation(const movement_animation_t *animation) {
+    if (animation == NULL || animation->num_frames == 0) {
+        movement_stop_animation();
+        return;
+    }
+
+    uint32_t frame_ticks = (animation->frame_duration_ms * watch_rtc_get_frequency() + 500) / 1000;
+    if (frame_ticks == 0) frame_ticks = 1;
+
+    // Make sure the comp callback can't observe a half-configured animation.
+    movement_volatile_state.animation = NULL;
+    watch_rtc_disable_comp_callback_no_schedule(ANIMATION_TIMEOUT);
+
+    _movement_show_animation_frame(animation, 0);
+
+    movement_volatile_state.animation_frame = 1;
+    movement_volatile_state.animation_frame_ticks = frame_ticks;
+    movement_volatile_state.animation_counter = watch_rtc_get_counter() + frame_ticks;
+    movement_volatile_state.animation = animation;
+
+    watch_rtc_register_comp_callback_no_schedule(cb_animation_frame, movement_volatile_state.animation_counter, ANIMATION_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+void movement_stop_animation(void) {
+    if (movement_volatile_state.animation == NULL) return;
+
+    movement_volatile_state.animation = NULL;
+    watch_rtc_disable_comp_callback_no_schedule(ANIMATION_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+bool movement_animation_is_running(void) {
+    return movement_volatile_state.animation != NULL;
+}
+
+void movement_start_beats(const movement_beat_pattern_t *pattern) {
+    if (pattern == NULL || pattern->num_steps == 0 || pattern->centibeats_per_minute == 0) {
+        movement_stop_beats();
+        return;
+    }
+
+    // Make sure the comp callback can't observe a half-configured pattern.
+    movement_volatile_state.beat_pattern = NULL;
+    watch_rtc_disable_comp_callback_no_schedule(BEAT_TIMEOUT);
+
+    // One beat lasts 60 * 100 * freq / centibeats_per_minute ticks; keep the fraction so it never rounds away.
+    uint32_t ticks_per_minute_x100 = 6000 * watch_rtc_get_frequency();
+    movement_volatile_state.beat_period_ticks = ticks_per_minute_x100 / pattern->centibeats_per_minute;
+    movement_volatile_state.beat_period_remainder = ticks_per_minute_x100 % pattern->centibeats_per_minute;
+    movement_volatile_state.beat_error = 0;
+    movement_volatile_state.beat_index = 0;
+    movement_volatile_state.beat_step = 0;
+    movement_volatile_state.beat_step_beat = 0;
+    movement_volatile_state.beat_fired = false;
+    movement_volatile_state.beat_cue = NULL;
+    movement_volatile_state.beat_counter = watch_rtc_get_counter() + 1;
+
+    _movement_beat_stats.start_counter = movement_volatile_state.beat_counter;
+    _movement_beat_stats.num_beats = 0;
+    _movement_beat_stats.max_late_ticks = 0;
+
+    movement_volatile_state.beat_pattern = pattern;
+
+    watch_rtc_register_comp_callback_no_schedule(cb_beat, movement_volatile_state.beat_counter, BEAT_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+void movement_stop_beats(void) {
+    if (movement_volatile_state.beat_pattern == NULL) return;
+
+    movement_volatile_state.beat_pattern = NULL;
+    movement_volatile_state.beat_fired = false;
+    movement_volatile_state.beat_cue = NULL;
+    watch_rtc_disable_comp_callback_no_schedule(BEAT_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+bool movement_beats_are_running(void) {
+    return movement_volatile_state.beat_pattern != NULL;
+}
+
+static void _movement_play_beat_cues(const movement_beat_step_t *step, rtc_counter_t beat_counter) {
+    if (step->sequence != NULL) {
+        movement_play_sequence(step->sequence, BUZZER_PRIORITY_BUTTON);
+    }
+    // the LED goes off led_ticks after the beat itself, however late the loop got to it; if that has passed, skip it.
+    rtc_counter_t off_counter = beat_counter + step->led_ticks;
+    if (step->led_ticks && (int32_t)(off_counter - watch_rtc_get_counter()) > 0) {
+        movement_force_led_on(step->led_red, step->led_green, step->led_blue);
+        watch_rtc_register_comp_callback_no_schedule(cb_led_timeout_interrupt, off_counter, LED_TIMEOUT);
+        movement_volatile_state.schedule_next_comp = true;
+    }
+}
+
+void movement_coroutine_wake_at(rtc_counter_t counter) {
+    watch_rtc_register_comp_callback_no_schedule(cb_coroutine, counter, COROUTINE_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+void movement_coroutine_wake_on_buzzer(void) {
+    movement_volatile_state.coroutine_wants_buzzer = true;
+}
+
+void movement_coroutine_cancel_wake(void) {
+    movement_volatile_state.coroutine_wants_buzzer = false;
+    watch_rtc_disable_comp_callback_no_schedule(COROUTINE_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+bool movement_coroutine_deadline_passed(rtc_counter_t deadline) {
+    return (int32_t)(watch_rtc_get_counter() - deadline) >= 0;
+}
+
+uint32_t movement_coroutine_ms_to_ticks(uint32_t ms) {
+    return (ms * watch_rtc_get_frequency() + 500) / 1000;
+}
+
+bool movement_buzzer_is_playing(void) {
+    return movement_volatile_state.is_buzzing;
+}
+
+// Redraw on change. Only the foreground face can track a value, so there is one of these.
+typedef struct {
+    movement_display_value_t value_at;
+    void *context;
+    uint32_t value;     // the value the face was last told about
+} movement_redraw_t;
+
+static movement_redraw_t _movement_redraw;
+
+// Look no further ahead than this for the next change; if there isn't one by then, wake and look again.
+#define MOVEMENT_REDRAW_HORIZON_SECONDS 64
+
+// The timestamp advances when the counter's subsecond bits reach half_freq, so the second that holds a counter value
+// starts (counter + half_freq) & subsecond_mask ticks before it. This is cb_tick's subsecond, at full resolution.
+static uint32_t _movement_redraw_value_at(rtc_counter_t counter, rtc_counter_t now, uint32_t now_timestamp) {
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t half_freq = freq >> 1;
+    uint32_t subsecond_mask = freq - 1;
+    uint32_t ticks = (counter + half_freq) & subsecond_mask;
+    rtc_counter_t second_start = counter - ticks;
+    rtc_counter_t now_second_start = now - ((now + half_freq) & subsecond_mask);
+
+    return _movement_redraw.value_at(now_timestamp + (second_start - now_second_start) / freq, ticks, _movement_redraw.context);
+}
+
+static void _movement_redraw_read_clock(rtc_counter_t *counter, uint32_t *timestamp) {
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t half_freq = freq >> 1;
+    rtc_counter_t before;
+
+    // both are read from the counter, which may tick over in between. Try again if it crossed a second boundary.
+    do {
+        before = watch_rtc_get_counter();
+        *timestamp = watch_rtc_get_unix_time();
+        *counter = watch_rtc_get_counter();
+    } while ((before + half_freq) / freq != (*counter + half_freq) / freq);
+}
+
+// Samples the value, and arms REDRAW_TIMEOUT for the first tick on which it differs from that. Returns the sample.
+static uint32_t _movement_redraw_arm(void) {
+    rtc_counter_t now;
+    uint32_t now_timestamp;
+    _movement_redraw_read_clock(&now, &now_timestamp);
+
+    uint32_t value = _movement_redraw_value_at(now, now, now_timestamp);
+    uint32_t horizon = MOVEMENT_REDRAW_HORIZON_SECONDS * watch_rtc_get_frequency();
+
+    // Gallop ahead until the value differs, then narrow down the step that crossed the change. This finds the first
+    // change as long as the value doesn't change and change back within one step, which a displayed value won't.
+    uint32_t same = 0;
+    uint32_t step = 1;
+    uint32_t changed = 0;
+    while (same < horizon) {
+        uint32_t probe = same + step;
+        if (probe > horizon) probe = horizon;
+        if (_movement_redraw_value_at(now + probe, now, now_timestamp) != value) {
+            changed = probe;
+            break;
+        }
+        same = probe;
+        step <<= 1;
+    }
+
+    if (changed) {
+        while (changed - same > 1) {
+            uint32_t middle = same + (changed - same) / 2;
+            if (_movement_redraw_value_at(now + middle, now, now_timestamp) != value) changed = middle;
+            else same = middle;
+        }
+    } else {
+        changed = horizon;
+    }
+
+    watch_rtc_register_comp_callback_no_schedule(cb_redraw, now + changed, REDRAW_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+
+    return value;
+}
+
+void movement_redraw_on_change(movement_display_value_t value_at, void *context) {
+    _movement_redraw.value_at = value_at;
+    _movement_redraw.context = context;
+    movement_volatile_state.redraw_due = false;
+    _movement_redraw.value = _movement_redraw_arm();
+}
+
+void movement_redraw_cancel(void) {
+    if (_movement_redraw.value_at == NULL) return;
+
+    _movement_redraw.value_at = NULL;
+    movement_volatile_state.redraw_due = false;
+    watch_rtc_disable_comp_callback_no_schedule(REDRAW_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+uint32_t movement_redraw_get_value(void) {
+    return _movement_redraw.value;
+}
+
 void movement_illuminate_led(void) {
+    // the LED can't be seen in daylight anyway.
+    if (movement_state.has_opt3001 && _movement_light.band == MOVEMENT_LIGHT_BAND_DAYLIGHT) return;
+
     if (movement_state.settings.bit.led_duration != 0b111) {
         movement_state.light_on = true;
         watch_set_led_color_rgb(movement_state.settings.bit.led_red_color | movement_state.settings.bit.led_red_color << 4,
@@ -520,6 +1190,67 @@ void movement_move_to_next_face(void) {
     movement_move_to_face((movement_state.current_face_idx + 1) % face_max);
 }
 
+rtc_counter_t movement_get_button_event_counter(movement_event_type_t event_type) {
+    movement_button_t* button;
+
+    if (event_type >= EVENT_LIGHT_BUTTON_DOWN && event_type <= EVENT_LIGHT_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.light_button;
+    } else if (event_type >= EVENT_MODE_BUTTON_DOWN && event_type <= EVENT_MODE_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.mode_button;
+    } else if (event_type >= EVENT_ALARM_BUTTON_DOWN && event_type <= EVENT_ALARM_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.alarm_button;
+    } else if (event_type == EVENT_SINGLE_TAP || event_type == EVENT_DOUBLE_TAP) {
+        return movement_volatile_state.accelerometer_counter;
+    } else {
+        return watch_rtc_get_counter();
+    }
+
+    // up and long up events are timestamped on the release edge, everything else on the press edge.
+    uint8_t offset = event_type - button->down_event;
+    if (offset == 1 || offset == 3) {
+        return button->up_timestamp;
+    }
+
+    return button->down_timestamp;
+}
+
+uint32_t movement_get_button_event_capture(movement_event_type_t event_type) {
+    movement_button_t* button;
+
+    if (event_type >= EVENT_LIGHT_BUTTON_DOWN && event_type <= EVENT_LIGHT_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.light_button;
+    } else if (event_type >= EVENT_MODE_BUTTON_DOWN && event_type <= EVENT_MODE_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.mode_button;
+    } else if (event_type >= EVENT_ALARM_BUTTON_DOWN && event_type <= EVENT_ALARM_REALLY_LONG_PRESS) {
+        button = &movement_volatile_state.alarm_button;
+    } else {
+        return watch_rtc_get_counter() * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency());
+    }
+
+    uint8_t offset = event_type - button->down_event;
+    if (offset == 1 || offset == 3) {
+        return button->up_capture;
+    }
+
+    return button->down_capture;
+}
+
+bool movement_enable_button_capture(void) {
+    const uint8_t pins[] = { HAL_GPIO_BTN_ALARM_pin(), HAL_GPIO_BTN_LIGHT_pin() };
+    bool enabled = watch_enable_capture(pins, sizeof(pins) / sizeof(pins[0]));
+
+    movement_volatile_state.alarm_button.is_captured = enabled;
+    movement_volatile_state.light_button.is_captured = enabled;
+
+    return enabled;
+}
+
+void movement_disable_button_capture(void) {
+    movement_volatile_state.alarm_button.is_captured = false;
+    movement_volatile_state.light_button.is_captured = false;
+    watch_disable_capture();
+}
+
 void movement_schedule_background_task(watch_date_time_t date_time) {
     movement_schedule_background_task_for_face(movement_state.current_face_idx, date_time);
 }
@@ -531,6 +1262,10 @@ void movement_cancel_background_task(void) {
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
     watch_date_time_t now = watch_rtc_get_date_time();
     if (date_time.reg > now.reg) {
+        // a face that turned its ticks off still needs Movement's 1 Hz tick to check on the task.
+        if (!movement_state.has_scheduled_background_task && movement_state.tick_frequency == 0) {
+            watch_rtc_register_tick_callback(cb_tick);
+        }
         movement_state.has_scheduled_background_task = true;
         scheduled_tasks[watch_face_index].reg = date_time.reg;
     }
@@ -548,6 +1283,151 @@ void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
     movement_state.has_scheduled_background_task = other_tasks_scheduled;
 }
 
+bool movement_timer_start(uint8_t watch_face_index, uint8_t timer_id, uint32_t target_timestamp) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES || timer_id >= MOVEMENT_NUM_TIMER_IDS) return false;
+    if (target_timestamp <= watch_rtc_get_unix_time()) return false;
+
+    movement_timer_t *timer = _movement_find_timer(watch_face_index, timer_id);
+    for (uint8_t i = 0; timer == NULL && i < MOVEMENT_NUM_TIMERS; i++) {
+        if (_movement_timers[i].target == 0) timer = &_movement_timers[i];
+    }
+    if (timer == NULL) return false;
+
+    timer->target = target_timestamp;
+    timer->watch_face_index = watch_face_index;
+    timer->timer_id = timer_id;
+    _movement_store_timer(timer - _movement_timers);
+    _movement_schedule_next_timer();
+
+    return true;
+}
+
+void movement_timer_cancel(uint8_t watch_face_index, uint8_t timer_id) {
+    movement_timer_t *timer = _movement_find_timer(watch_face_index, timer_id);
+    if (timer == NULL) return;
+
+    timer->target = 0;
+    _movement_store_timer(timer - _movement_timers);
+    _movement_schedule_next_timer();
+}
+
+bool movement_timer_is_running(uint8_t watch_face_index, uint8_t timer_id) {
+    return _movement_find_timer(watch_face_index, timer_id) != NULL;
+}
+
+uint32_t movement_timer_get_target(uint8_t watch_face_index, uint8_t timer_id) {
+    movement_timer_t *timer = _movement_find_timer(watch_face_index, timer_id);
+    return timer ? timer->target : 0;
+}
+
+uint32_t movement_timer_get_remaining(uint8_t watch_face_index, uint8_t timer_id) {
+    movement_timer_t *timer = _movement_find_timer(watch_face_index, timer_id);
+    if (timer == NULL) return 0;
+
+    uint32_t now = watch_rtc_get_unix_time();
+    return timer->target > now ? timer->target - now : 0;
+}
+
+void movement_timer_format_remaining(char *buf, uint32_t seconds) {
+    watch_duration_t duration = watch_utility_seconds_to_duration(seconds);
+    uint32_t hours = duration.days * 24 + duration.hours;
+    if (hours > 99) hours = 99;
+    sprintf(buf, "%2lu%02d%02d", (unsigned long)hours, duration.minutes, duration.seconds);
+}
+
+static movement_job_t *_movement_find_job(uint8_t watch_face_index, uint8_t job_id) {
+    for (uint8_t i = 0; i < MOVEMENT_NUM_JOBS; i++) {
+        movement_job_t *job = &_movement_jobs[i];
+        if (job->step && job->watch_face_index == watch_face_index && job->job_id == job_id) {
+            return job;
+        }
+    }
+    return NULL;
+}
+
+bool movement_job_submit(uint8_t watch_face_index, uint8_t job_id, movement_job_step_t step, void *context, uint32_t deadline_ms) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES || job_id >= MOVEMENT_NUM_JOB_IDS || step == NULL) return false;
+
+    movement_job_t *job = _movement_find_job(watch_face_index, job_id);
+    if (job == NULL) {
+        for (uint8_t i = 0; i < MOVEMENT_NUM_JOBS; i++) {
+            if (_movement_jobs[i].step == NULL) {
+                job = &_movement_jobs[i];
+                break;
+            }
+        }
+        if (job == NULL) return false;
+        _movement_job_stats.depth++;
+        if (_movement_job_stats.depth > _movement_job_stats.max_depth) _movement_job_stats.max_depth = _movement_job_stats.depth;
+    }
+
+    job->step = step;
+    job->context = context;
+    // deadlines are compared as signed differences, so anything past half the counter's range is as good as never.
+    uint64_t deadline_ticks = ((uint64_t)deadline_ms * watch_rtc_get_frequency() + 500) / 1000;
+    if (deadline_ticks > INT32_MAX) deadline_ticks = INT32_MAX;
+    job->deadline = watch_rtc_get_counter() + (rtc_counter_t)deadline_ticks;
+    job->watch_face_index = watch_face_index;
+    job->job_id = job_id;
+    _movement_job_stats.num_submitted++;
+
+    return true;
+}
+
+void movement_job_cancel(uint8_t watch_face_index, uint8_t job_id) {
+    movement_job_t *job = _movement_find_job(watch_face_index, job_id);
+    if (job == NULL) return;
+
+    job->step = NULL;
+    _movement_job_stats.depth--;
+}
+
+bool movement_job_is_queued(uint8_t watch_face_index, uint8_t job_id) {
+    return _movement_find_job(watch_face_index, job_id) != NULL;
+}
+
+// Runs one slice of the job with the earliest deadline, and tells its face if it finishes.
+static void _movement_run_job_slice(void) {
+    rtc_counter_t start = watch_rtc_get_counter();
+    movement_job_t *job = NULL;
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_JOBS; i++) {
+        movement_job_t *candidate = &_movement_jobs[i];
+        if (candidate->step == NULL) continue;
+        if (job == NULL || (int32_t)(candidate->deadline - job->deadline) < 0) job = candidate;
+    }
+    if (job == NULL) return;
+
+    uint32_t budget_ticks = (MOVEMENT_JOB_SLICE_MS * watch_rtc_get_frequency() + 500) / 1000;
+    if (budget_ticks == 0) budget_ticks = 1;
+
+    movement_job_step_t step = job->step;
+    bool done;
+    uint32_t elapsed_ticks;
+    do {
+        done = step(job->context);
+        _movement_job_stats.num_steps++;
+        elapsed_ticks = watch_rtc_get_counter() - start;
+        // the step may have cancelled or resubmitted its own job
+    } while (!done && job->step == step && elapsed_ticks < budget_ticks);
+
+    _movement_job_stats.num_slices++;
+    if (elapsed_ticks > budget_ticks) _movement_job_stats.num_overruns++;
+    if (elapsed_ticks > _movement_job_stats.max_slice_ticks) _movement_job_stats.max_slice_ticks = elapsed_ticks;
+
+    if (!done || job->step != step) return;
+
+    // free the slot first, in case the face wants to submit the job again.
+    job->step = NULL;
+    _movement_job_stats.depth--;
+    _movement_job_stats.num_completed++;
+    if ((int32_t)(watch_rtc_get_counter() - job->deadline) > 0) _movement_job_stats.num_late++;
+
+    uint8_t watch_face_index = job->watch_face_index;
+    movement_event_t job_event = { EVENT_JOB_DONE, job->job_id };
+    _movement_face_loop(watch_face_index, job_event);
+}
+
 void movement_request_sleep(void) {
     movement_volatile_state.enter_sleep_mode = true;
 }
@@ -564,6 +1444,10 @@ void cb_buzzer_start(void) {
 void cb_buzzer_stop(void) {
     movement_volatile_state.is_buzzing = false;
     movement_volatile_state.pending_sequence_priority = 0;
+    if (movement_volatile_state.coroutine_wants_buzzer) {
+        movement_volatile_state.coroutine_wants_buzzer = false;
+        movement_volatile_state.pending_events |= 1 << EVENT_COROUTINE_RESUME;
+    }
 }
 
 void movement_play_note(watch_buzzer_note_t note, uint16_t duration_ms) {
@@ -584,6 +1468,15 @@ void movement_play_signal(void) {
     movement_play_sequence(signal_tune, BUZZER_PRIORITY_SIGNAL);
 }
 
+bool movement_in_quiet_hours(void) {
+    uint8_t hour = movement_get_local_date_time().unit.hour;
+
+    if (MOVEMENT_QUIET_HOURS_START <= MOVEMENT_QUIET_HOURS_END) {
+        return hour >= MOVEMENT_QUIET_HOURS_START && hour < MOVEMENT_QUIET_HOURS_END;
+    }
+    return hour >= MOVEMENT_QUIET_HOURS_START || hour < MOVEMENT_QUIET_HOURS_END;
+}
+
 void movement_play_alarm(void) {
     movement_play_sequence(alarm_tune, BUZZER_PRIORITY_ALARM);
 }
@@ -712,6 +1605,8 @@ void movement_set_utc_timestamp(uint32_t timestamp) {
 
     // If the time was changed, the top of the minute alarm needs to be reset accordingly
     _movement_set_top_of_minute_alarm();
+    // and the timer service's compare has to move to wherever its soonest target now falls on the counter.
+    _movement_schedule_next_timer();
 
     // this may seem wasteful, but if the user's local time is in a zone that observes DST,
     // they may have just crossed a DST boundary, which means the next call to this function
@@ -811,6 +1706,8 @@ void movement_store_settings(void) {
     if (movement_state.settings.reg != old_settings.reg) {
         filesystem_write_file("settings.u32", (char *)&movement_state.settings, sizeof(movement_settings_t));
     }
+    // keep the copy that a reset restores from up to date too.
+    watch_store_backup_data(movement_state.settings.reg, 0);
 }
 
 bool movement_alarm_enabled(void) {
@@ -914,25 +1811,277 @@ float movement_get_temperature(void) {
             val = val >> 4;
             temperature_c = 25 + (float)val / 16.0;
     }
-#endif
+#endif
+
+    return temperature_c;
+}
+
+#ifdef I2C_SERCOM
+// Programs the thresholds around the current band. With brighter_only, only rising out of it raises the interrupt.
+static void _movement_light_set_window(bool brighter_only) {
+    uint32_t low = brighter_only ? 0 : _movement_light_band_low[_movement_light.band];
+    opt3001_writeLimit(MOVEMENT_OPT3001_ADDRESS, OPT3001_LOW_LIMIT, opt3001_fromCentilux(low));
+    opt3001_writeLimit(MOVEMENT_OPT3001_ADDRESS, OPT3001_HIGH_LIMIT, opt3001_fromCentilux(_movement_light_band_high[_movement_light.band]));
+}
+
+static void _movement_light_begin(void) {
+    static const opt3001_Config_t continuous = {
+        .RangeNumber = 0b1100,                  // automatic full-scale
+        .ConversionTime = 0b1,                  // 800 ms, the lowest power per conversion
+        .ModeOfConversionOperation = 0b11,      // continuous
+        .Latch = 0b1,                           // window comparison: INT stays low until we read the config
+        .Polarity = 0b0,                        // active low
+        .FaultCount = 0b01,                     // two conversions in a row outside the window, to ignore flicker
+    };
+
+    // reading the config releases INT if it was latched while we were away.
+    opt3001_readConfig(MOVEMENT_OPT3001_ADDRESS);
+    _movement_light_set_window(false);
+    opt3001_writeConfig(MOVEMENT_OPT3001_ADDRESS, continuous);
+}
+
+static movement_light_band_t _movement_light_band_for(uint32_t centilux) {
+    movement_light_band_t band = _movement_light.band;
+    while (band > MOVEMENT_LIGHT_BAND_DARK && centilux < _movement_light_band_low[band]) band--;
+    while (band < MOVEMENT_LIGHT_BAND_DAYLIGHT && centilux > _movement_light_band_high[band]) band++;
+    return band;
+}
+#endif
+
+static void _movement_handle_light_interrupt(void) {
+#ifdef I2C_SERCOM
+    _movement_light.num_interrupts++;
+
+    // reading the config clears the latched flags and releases INT
+    opt3001_readConfig(MOVEMENT_OPT3001_ADDRESS);
+    uint32_t centilux = opt3001_toCentilux(opt3001_readResult(MOVEMENT_OPT3001_ADDRESS).raw);
+    movement_light_band_t band = _movement_light_band_for(centilux);
+    _movement_light.centilux = centilux;
+    if (band == _movement_light.band) return;
+
+    _movement_light.band = band;
+    _movement_light.num_changes++;
+    _movement_light_set_window(false);
+
+    movement_event_t event = { EVENT_LIGHT_BAND_CHANGED, band };
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES && i < 32; i++) {
+        if (_movement_light.subscribers & (1UL << i)) {
+            _movement_face_loop(i, event);
+        }
+    }
+#endif
+}
+
+movement_light_band_t movement_get_light_band(void) {
+    return _movement_light.band;
+}
+
+uint32_t movement_get_light_centilux(void) {
+    return _movement_light.centilux;
+}
+
+void movement_light_subscribe(uint8_t watch_face_index, bool subscribe) {
+    if (watch_face_index >= 32) return;
+
+    if (subscribe) {
+        _movement_light.subscribers |= 1UL << watch_face_index;
+    } else {
+        _movement_light.subscribers &= ~(1UL << watch_face_index);
+    }
+}
+
+bool movement_begin_performance_burst(void) {
+    if (_movement_burst.depth++) return _movement_burst.is_fast;
+
+    // The battery voltage changes slowly and takes a while to read, so check it at most once an hour.
+    uint32_t now = movement_get_utc_timestamp();
+    if (_movement_burst.vcc == 0 || now - _movement_burst.vcc_timestamp >= 3600) {
+        _movement_burst.vcc = watch_get_vcc_voltage();
+        _movement_burst.vcc_timestamp = now;
+    }
+
+    _movement_burst.is_fast = _movement_burst.vcc >= MOVEMENT_BURST_MIN_VOLTAGE;
+    if (!_movement_burst.is_fast) {
+        _movement_burst.stats.num_refused++;
+        return false;
+    }
+
+    watch_set_cpu_high_performance(true);
+    _movement_burst.start_counter = watch_rtc_get_counter();
+
+    return true;
+}
+
+void movement_end_performance_burst(void) {
+    if (_movement_burst.depth == 0) return;
+    if (--_movement_burst.depth || !_movement_burst.is_fast) return;
+
+    watch_set_cpu_high_performance(false);
+    _movement_burst.is_fast = false;
+
+    // Most bursts are shorter than a tick, so a single estimate is coarse; the totals average out over many bursts.
+    uint32_t ticks = watch_rtc_get_counter() - _movement_burst.start_counter;
+    // millivolts times microamps is nanowatts; over the tick frequency that's nanojoules, and over 1000, microjoules.
+    uint32_t energy_uj = (uint64_t)_movement_burst.vcc * MOVEMENT_BURST_CURRENT_UA * ticks / (watch_rtc_get_frequency() * 1000ULL);
+
+    _movement_burst.stats.num_bursts++;
+    _movement_burst.stats.last_ticks = ticks;
+    _movement_burst.stats.last_energy_uj = energy_uj;
+    _movement_burst.stats.total_ticks += ticks;
+    _movement_burst.stats.total_energy_uj += energy_uj;
+}
+
+movement_burst_stats_t movement_get_burst_stats(void) {
+    return _movement_burst.stats;
+}
+
+#ifdef I2C_SERCOM
+// Leaves the accelerometer the way faces expect to find it: asleep until there's motion, with taps routed to A3.
+static void _movement_lis2dw_setup(void) {
+    lis2dw_set_mode(LIS2DW_MODE_LOW_POWER);         // select low power (not high performance) mode
+    lis2dw_set_low_power_mode(LIS2DW_LP_MODE_1);    // lowest power mode, 12-bit
+    lis2dw_set_low_noise_mode(false);               // low noise mode raises power consumption slightly; we don't need it
+    lis2dw_enable_stationary_motion_detection();    // stationary/motion detection mode keeps the data rate at 1.6 Hz even in sleep
+    lis2dw_set_range(LIS2DW_RANGE_2_G);             // Application note AN5038 recommends 2g range
+    lis2dw_enable_sleep();                          // allow acceleromter to sleep and wake on activity
+    lis2dw_configure_wakeup_threshold(movement_state.accelerometer_motion_threshold); // g threshold to wake up: (THS * FS / 64) where FS is "full scale" of ±2g.
+    lis2dw_configure_6d_threshold(3);               // 0-3 is 80, 70, 60, or 50 degrees. 50 is least precise, hopefully most sensitive?
+
+    // set up interrupts:
+    // INT1 is wired to pin A3. We'll configure the accelerometer to output an interrupt on INT1 when it detects an orientation change.
+    /// TODO: We had routed this interrupt to TC2 to count orientation changes, but TC2 consumed too much power.
+    /// Orientation changes helped with sleep tracking; would love to bring this back if we can find a low power solution.
+    /// For now, commenting these lines out; check commit 27f0c629d865f4bc56bc6e678da1eb8f4b919093 for power-hungry but working code.
+    // lis2dw_configure_int1(LIS2DW_CTRL4_INT1_6D);
+    // HAL_GPIO_A3_in();
+
+    // next: INT2 is wired to pin A4. We'll configure the accelerometer to output the sleep state on INT2.
+    // a falling edge on INT2 indicates the accelerometer has woken up.
+    lis2dw_configure_int2(LIS2DW_CTRL5_INT2_SLEEP_STATE | LIS2DW_CTRL5_INT2_SLEEP_CHG);
+    HAL_GPIO_A4_in();
+
+    // Wake on motion seemed like a good idea when the threshold was lower, but the UX makes less sense now.
+    // Still if you want to wake on motion, you can do it by uncommenting this line:
+    // watch_register_extwake_callback(HAL_GPIO_A4_pin(), cb_accelerometer_wake, false);
+
+    // later on, we are going to use INT1 for tap detection. We'll set up that interrupt here,
+    // but it will only fire once tap recognition is enabled.
+    watch_register_interrupt_callback(HAL_GPIO_A3_pin(), cb_accelerometer_event, INTERRUPT_TRIGGER_RISING);
+
+    // Enable the interrupts...
+    lis2dw_enable_interrupts();
+
+    // At first boot, this next line sets the accelerometer's sampling rate to 0, which is LIS2DW_DATA_RATE_POWERDOWN.
+    // This means the interrupts we just configured won't fire.
+    // Tap detection will ramp up sesing and make use of the A3 interrupt.
+    // If a watch face wants to check in on the A4 interrupt pin for motion status, it can call
+    // movement_set_accelerometer_background_rate with another rate like LIS2DW_DATA_RATE_LOWEST or LIS2DW_DATA_RATE_25_HZ.
+    lis2dw_set_data_rate(movement_state.accelerometer_background_rate);
+}
+
+// Starts the light sensor comparing against the current band, and listens for it on A2.
+static void _movement_opt3001_setup(void) {
+    watch_disable_extwake_interrupt(HAL_GPIO_A2_pin());
+    _movement_light_begin();
+    watch_register_interrupt_callback(HAL_GPIO_A2_pin(), cb_light_sensor_interrupt, INTERRUPT_TRIGGER_FALLING);
+    watch_enable_pull_up(HAL_GPIO_A2_pin());
+    // catch up on whatever the light did while we weren't listening.
+    movement_volatile_state.has_pending_light = true;
+}
+#endif
+
+static bool _movement_boot_sensors(void) {
+#ifdef I2C_SERCOM
+    watch_enable_i2c();
+    movement_state.has_lis2dw = lis2dw_begin();
+    if (movement_state.has_lis2dw) _movement_lis2dw_setup();
+
+    movement_state.has_opt3001 = opt3001_readManufacturerID(MOVEMENT_OPT3001_ADDRESS) == OPT3001_MANUFACTURER_ID_TI;
+    if (movement_state.has_opt3001) {
+        _movement_light.start_counter = watch_rtc_get_counter();
+        _movement_opt3001_setup();
+    }
+
+    if (!movement_state.has_lis2dw && !movement_state.has_opt3001) watch_disable_i2c();
+#endif
+    return true;
+}
+
+static bool _movement_boot_thermistor(void) {
+    movement_state.has_thermistor = thermistor_driver_init();
+    return true;
+}
+
+static bool _movement_boot_faces(void) {
+    _movement_set_up_faces();
+    return true;
+}
+
+static bool _movement_boot_filesystem(void) {
+    // already mounted if the settings had to come from their file, or a face's setup read one.
+    filesystem_init();
+    return true;
+}
+
+static bool _movement_boot_usb(void) {
+    rtc_counter_t settled_counter = _movement_boot.vbus_counter + MOVEMENT_VBUS_SETTLE_TICKS;
+    if ((int32_t)(settled_counter - watch_rtc_get_counter()) > 0) {
+        // sleep until the line has settled, rather than spin on it.
+        watch_rtc_register_comp_callback_no_schedule(cb_boot_step, settled_counter, BOOT_TIMEOUT);
+        movement_volatile_state.schedule_next_comp = true;
+        return false;
+    }
+
+    if (HAL_GPIO_VBUS_DET_read()) {
+        // we're plugged into USB power, so enable USB functionality.
+        _watch_enable_usb();
+    }
+    HAL_GPIO_VBUS_DET_off();
+    return true;
+}
+
+static const movement_boot_step_t _movement_boot_steps[MOVEMENT_NUM_BOOT_STEPS] = {
+    [MOVEMENT_BOOT_SENSORS] = { "sensors", _movement_boot_sensors },
+    [MOVEMENT_BOOT_THERMISTOR] = { "thermistor", _movement_boot_thermistor },
+    [MOVEMENT_BOOT_FACES] = { "faces", _movement_boot_faces },
+    [MOVEMENT_BOOT_FILESYSTEM] = { "filesystem", _movement_boot_filesystem },
+    [MOVEMENT_BOOT_USB] = { "usb", _movement_boot_usb },
+};
+
+// Runs the next boot step, and returns true if it finished.
+static bool _movement_run_boot_step(void) {
+    rtc_counter_t start = watch_rtc_get_counter();
+    bool done = _movement_boot_steps[_movement_boot.step].run();
+    rtc_counter_t end = watch_rtc_get_counter();
+
+    _movement_boot.step_ticks[_movement_boot.step] += end - start;
+    if (!done) return false;
+
+    if (++_movement_boot.step == MOVEMENT_NUM_BOOT_STEPS) {
+        _movement_boot.ready_counter = end;
+        WATCH_LOG_INFO("boot: first face drawn after %lu ticks, ready after %lu",
+            _movement_boot.first_pixel_counter - _movement_boot.init_counter, end - _movement_boot.init_counter);
+    }
 
-    return temperature_c;
+    return true;
 }
 
 void app_init(void) {
-    _watch_init();
+#if !__EMSCRIPTEN__
+    // Paint the stack before anything else runs, so the stack command can tell how much of it has ever been used.
+    _movement_stack_paint(&_sstack);
+#ifdef MOVEMENT_STACK_PROFILING
+    _movement_stack.low_water = _movement_stack_lowest_used(&_sstack);
+#endif
+#endif
 
-    filesystem_init();
+    _watch_init();
+    _movement_boot.init_counter = watch_rtc_get_counter();
 
-    // check if we are plugged into USB power.
+    // start draining the VBUS detect line; the usb boot step reads it once it has settled.
     HAL_GPIO_VBUS_DET_in();
     HAL_GPIO_VBUS_DET_pulldown();
-    delay_ms(100);
-    if (HAL_GPIO_VBUS_DET_read()){
-        /// if so, enable USB functionality.
-        _watch_enable_usb();
-    }
-    HAL_GPIO_VBUS_DET_off();
+    _movement_boot.vbus_counter = _movement_boot.init_counter;
 
     memset((void *)&movement_state, 0, sizeof(movement_state));
 
@@ -941,6 +2090,7 @@ void app_init(void) {
 
     movement_volatile_state.minute_alarm_fired = false;
     movement_volatile_state.minute_counter = 0;
+    movement_volatile_state.timer_fired = false;
 
     movement_volatile_state.enter_sleep_mode = false;
     movement_volatile_state.exit_sleep_mode = false;
@@ -951,34 +2101,44 @@ void app_init(void) {
     movement_volatile_state.is_buzzing = false;
     movement_volatile_state.pending_sequence_priority = 0;
 
+    movement_volatile_state.animation = NULL;
+
     movement_volatile_state.mode_button.down_event = EVENT_MODE_BUTTON_DOWN;
     movement_volatile_state.mode_button.is_down = false;
     movement_volatile_state.mode_button.down_timestamp = 0;
+    movement_volatile_state.mode_button.up_timestamp = 0;
     movement_volatile_state.mode_button.timeout_index = MODE_BUTTON_TIMEOUT;
     movement_volatile_state.mode_button.cb_longpress = cb_mode_btn_timeout_interrupt;
+    movement_volatile_state.mode_button.pin = HAL_GPIO_BTN_MODE_pin();
 
     movement_volatile_state.light_button.down_event = EVENT_LIGHT_BUTTON_DOWN;
     movement_volatile_state.light_button.is_down = false;
     movement_volatile_state.light_button.down_timestamp = 0;
+    movement_volatile_state.light_button.up_timestamp = 0;
     movement_volatile_state.light_button.timeout_index = LIGHT_BUTTON_TIMEOUT;
     movement_volatile_state.light_button.cb_longpress = cb_light_btn_timeout_interrupt;
+    movement_volatile_state.light_button.pin = HAL_GPIO_BTN_LIGHT_pin();
 
     movement_volatile_state.alarm_button.down_event = EVENT_ALARM_BUTTON_DOWN;
     movement_volatile_state.alarm_button.is_down = false;
     movement_volatile_state.alarm_button.down_timestamp = 0;
+    movement_volatile_state.alarm_button.up_timestamp = 0;
     movement_volatile_state.alarm_button.timeout_index = ALARM_BUTTON_TIMEOUT;
     movement_volatile_state.alarm_button.cb_longpress = cb_alarm_btn_timeout_interrupt;
+    movement_volatile_state.alarm_button.pin = HAL_GPIO_BTN_ALARM_pin();
 
-    movement_state.has_thermistor = thermistor_driver_init();
-
-    bool settings_file_exists = filesystem_file_exists("settings.u32");
+    // A reset that the RTC lived through also left the settings in backup register 0, which saves mounting the
+    // filesystem before the first face draws. After a battery swap, they have to come from their file.
     movement_settings_t maybe_settings;
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
+    maybe_settings.reg = watch_rtc_get_date_time().reg ? watch_get_backup_data(0) : 0;
+    bool have_settings = maybe_settings.reg != 0 && maybe_settings.bit.version == 0;
+    if (!have_settings && filesystem_file_exists("settings.u32")) {
         filesystem_read_file("settings.u32", (char *) &maybe_settings, sizeof(movement_settings_t));
+        have_settings = true;
     }
 
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
-        // If settings file exists and has a valid version, restore it!
+    if (have_settings && maybe_settings.bit.version == 0) {
+        // If saved settings exist and have a valid version, restore them!
         movement_state.settings.reg = maybe_settings.reg;
     } else {
         // Otherwise set default values.
@@ -1039,6 +2199,9 @@ void app_init(void) {
     movement_state.next_available_backup_register = 2;
     _movement_reset_inactivity_countdown();
 
+    // pick up any countdowns that were running before a reset
+    _movement_restore_timers();
+
     // set up the 1 minute alarm (for background tasks and low power updates)
     _movement_set_top_of_minute_alarm();
 }
@@ -1085,70 +2248,33 @@ void app_setup(void) {
         watch_register_interrupt_callback(HAL_GPIO_BTN_MODE_pin(), cb_mode_btn_interrupt, INTERRUPT_TRIGGER_BOTH);
         watch_register_interrupt_callback(HAL_GPIO_BTN_LIGHT_pin(), cb_light_btn_interrupt, INTERRUPT_TRIGGER_BOTH);
         watch_register_interrupt_callback(HAL_GPIO_BTN_ALARM_pin(), cb_alarm_btn_interrupt, INTERRUPT_TRIGGER_BOTH);
+        // sleep mode stopped the capture timers; a face that wanted capture still does.
+        if (movement_volatile_state.alarm_button.is_captured) movement_enable_button_capture();
 
 #ifdef I2C_SERCOM
-        static bool lis2dw_checked = false;
-        if (!lis2dw_checked) {
-            watch_enable_i2c();
-            if (lis2dw_begin()) {
-                movement_state.has_lis2dw = true;
-            } else {
-                movement_state.has_lis2dw = false;
-                watch_disable_i2c();
+        // At boot, the sensors are probed by a boot step just below. Each wake from low energy mode after that sets
+        // up the ones that were found.
+        if (_movement_boot.step > MOVEMENT_BOOT_SENSORS) {
+            if (movement_state.has_lis2dw) {
+                watch_enable_i2c();
+                lis2dw_begin();
+                _movement_lis2dw_setup();
+            }
+            if (movement_state.has_opt3001) {
+                watch_enable_i2c();
+                _movement_opt3001_setup();
             }
-            lis2dw_checked = true;
-        } else if (movement_state.has_lis2dw) {
-            watch_enable_i2c();
-            lis2dw_begin();
-        }
-
-        if (movement_state.has_lis2dw) {
-            lis2dw_set_mode(LIS2DW_MODE_LOW_POWER);         // select low power (not high performance) mode
-            lis2dw_set_low_power_mode(LIS2DW_LP_MODE_1);    // lowest power mode, 12-bit
-            lis2dw_set_low_noise_mode(false);               // low noise mode raises power consumption slightly; we don't need it
-            lis2dw_enable_stationary_motion_detection();    // stationary/motion detection mode keeps the data rate at 1.6 Hz even in sleep
-            lis2dw_set_range(LIS2DW_RANGE_2_G);             // Application note AN5038 recommends 2g range
-            lis2dw_enable_sleep();                          // allow acceleromter to sleep and wake on activity
-            lis2dw_configure_wakeup_threshold(movement_state.accelerometer_motion_threshold); // g threshold to wake up: (THS * FS / 64) where FS is "full scale" of ±2g.
-            lis2dw_configure_6d_threshold(3);               // 0-3 is 80, 70, 60, or 50 degrees. 50 is least precise, hopefully most sensitive?
-
-            // set up interrupts:
-            // INT1 is wired to pin A3. We'll configure the accelerometer to output an interrupt on INT1 when it detects an orientation change.
-            /// TODO: We had routed this interrupt to TC2 to count orientation changes, but TC2 consumed too much power.
-            /// Orientation changes helped with sleep tracking; would love to bring this back if we can find a low power solution.
-            /// For now, commenting these lines out; check commit 27f0c629d865f4bc56bc6e678da1eb8f4b919093 for power-hungry but working code.
-            // lis2dw_configure_int1(LIS2DW_CTRL4_INT1_6D);
-            // HAL_GPIO_A3_in();
-
-            // next: INT2 is wired to pin A4. We'll configure the accelerometer to output the sleep state on INT2.
-            // a falling edge on INT2 indicates the accelerometer has woken up.
-            lis2dw_configure_int2(LIS2DW_CTRL5_INT2_SLEEP_STATE | LIS2DW_CTRL5_INT2_SLEEP_CHG);
-            HAL_GPIO_A4_in();
-
-            // Wake on motion seemed like a good idea when the threshold was lower, but the UX makes less sense now.
-            // Still if you want to wake on motion, you can do it by uncommenting this line:
-            // watch_register_extwake_callback(HAL_GPIO_A4_pin(), cb_accelerometer_wake, false);
-
-            // later on, we are going to use INT1 for tap detection. We'll set up that interrupt here,
-            // but it will only fire once tap recognition is enabled.
-            watch_register_interrupt_callback(HAL_GPIO_A3_pin(), cb_accelerometer_event, INTERRUPT_TRIGGER_RISING);
-
-            // Enable the interrupts...
-            lis2dw_enable_interrupts();
-
-            // At first boot, this next line sets the accelerometer's sampling rate to 0, which is LIS2DW_DATA_RATE_POWERDOWN.
-            // This means the interrupts we just configured won't fire.
-            // Tap detection will ramp up sesing and make use of the A3 interrupt.
-            // If a watch face wants to check in on the A4 interrupt pin for motion status, it can call
-            // movement_set_accelerometer_background_rate with another rate like LIS2DW_DATA_RATE_LOWEST or LIS2DW_DATA_RATE_25_HZ.
-            lis2dw_set_data_rate(movement_state.accelerometer_background_rate);
         }
 #endif
 
+        // Faces look for the sensors in their setup, so these steps can't wait for the first draw.
+        while (_movement_boot.step < MOVEMENT_BOOT_FACES) _movement_run_boot_step();
+
         movement_request_tick_frequency(1);
 
+        // Before the first draw, only the face on screen is set up; the faces boot step sets up the rest.
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-            watch_faces[i].setup(i, &watch_face_contexts[i]);
+            if (_movement_boot.faces_set_up || i == movement_state.current_face_idx) watch_faces[i].setup(i, &watch_face_contexts[i]);
         }
 
         watch_faces[movement_state.current_face_idx].activate(watch_face_contexts[movement_state.current_face_idx]);
@@ -1176,10 +2302,21 @@ static void _sleep_mode_app_loop(void) {
             _movement_handle_top_of_minute();
         }
 
+        // the light sensor only interrupts in low energy mode when the light comes up from dark.
+        if (movement_volatile_state.has_pending_light) {
+            movement_volatile_state.exit_sleep_mode = true;
+        }
+
+        // and expired countdowns, which may well want to wake us up.
+        if (movement_volatile_state.timer_fired) {
+            movement_volatile_state.timer_fired = false;
+            _movement_handle_expired_timers();
+        }
+
         movement_event_t event;
         event.event_type = EVENT_LOW_ENERGY_UPDATE;
         event.subsecond = 0;
-        watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
+        _movement_face_loop(movement_state.current_face_idx, event);
 
         // If any of the previous loops requested to wake up, do it!
         if (movement_volatile_state.exit_sleep_mode) {
@@ -1206,6 +2343,16 @@ static bool _switch_face(void) {
     const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
 
     wf->resign(watch_face_contexts[movement_state.current_face_idx]);
+    movement_stop_animation();
+    movement_stop_beats();
+    movement_coroutine_cancel_wake();
+    movement_redraw_cancel();
+    // a face that left a performance burst running doesn't get to leave the CPU at full speed
+    if (_movement_burst.depth) {
+        _movement_burst.depth = 1;
+        movement_end_performance_burst();
+    }
+    _movement_set_up_faces();
     movement_state.current_face_idx = movement_state.next_face_idx;
     // we have just updated the face idx, so we must recache the watch face pointer.
     wf = &watch_faces[movement_state.current_face_idx];
@@ -1223,7 +2370,7 @@ static bool _switch_face(void) {
     event.subsecond = 0;
     event.event_type = EVENT_ACTIVATE;
     movement_state.watch_face_changed = false;
-    bool can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]);
+    bool can_sleep = _movement_face_loop(movement_state.current_face_idx, event);
 
     // Button events that follow a down event that happened on the previous face should not be forwarded to the new face
     movement_volatile_state.passthrough_events = _movement_button_events_mask;
@@ -1232,8 +2379,6 @@ static bool _switch_face(void) {
 }
 
 bool app_loop(void) {
-    const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
-
     // default to being allowed to sleep by the face.
     bool can_sleep = true;
 
@@ -1241,6 +2386,19 @@ bool app_loop(void) {
     uint32_t pending_events = movement_volatile_state.pending_events;
     movement_volatile_state.pending_events = 0;
 
+    // Events injected from the shell are timed from here until this pass is done with them.
+    bool injected = _movement_injection_stats.pending;
+    rtc_counter_t loop_counter = 0;
+    if (movement_volatile_state.injected_ticks) {
+        movement_volatile_state.injected_ticks--;
+        pending_events |= 1 << EVENT_TICK;
+        injected = true;
+    }
+    if (injected) {
+        _movement_injection_stats.pending = false;
+        loop_counter = watch_rtc_get_counter();
+    }
+
     movement_event_t event;
     event.event_type = EVENT_NONE;
     // Subsecond is determined by the TICK event, if concurrent events have happened,
@@ -1274,6 +2432,12 @@ bool app_loop(void) {
         _movement_handle_scheduled_tasks();
     }
 
+    // a face that asked for a tick frequency of 0 doesn't get the ticks Movement keeps for itself.
+    if (movement_state.tick_frequency == 0 && (pending_events & (1 << EVENT_TICK))) {
+        pending_events &= ~(1 << EVENT_TICK);
+        if (!movement_state.has_scheduled_background_task) watch_rtc_disable_tick_callback();
+    }
+
     // Pop the EVENT_TIMEOUT out of the pending_events so it can be handled separately
     bool resign_timeout = (pending_events & (1 << EVENT_TIMEOUT)) != 0;
     if (resign_timeout) {
@@ -1297,7 +2461,7 @@ bool app_loop(void) {
     while (pending_events) {
         uint8_t next_event = __builtin_ctz(pending_events);
         event.event_type = event_type + next_event;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
         pending_events = pending_events >> (next_event + 1);
         event_type = event_type + next_event + 1;
     }
@@ -1309,10 +2473,54 @@ bool app_loop(void) {
         _movement_handle_top_of_minute();
     }
 
+    // deliver any countdowns that the timer service's comp callback told us have expired
+    if (movement_volatile_state.timer_fired) {
+        movement_volatile_state.timer_fired = false;
+        _movement_handle_expired_timers();
+    }
+
+    // the light sensor has seen the light leave the current band's window
+    if (movement_volatile_state.has_pending_light) {
+        movement_volatile_state.has_pending_light = false;
+        _movement_handle_light_interrupt();
+    }
+
+    // Play the cues for the beat engine's latest step here rather than from its interrupt, where they could cut into
+    // a performance burst or the buzzer state the loop is in the middle of changing.
+    const movement_beat_step_t *beat_cue = movement_volatile_state.beat_cue;
+    if (beat_cue != NULL) {
+        rtc_counter_t beat_cue_counter = movement_volatile_state.beat_cue_counter;
+        movement_volatile_state.beat_cue = NULL;
+        _movement_play_beat_cues(beat_cue, beat_cue_counter);
+    }
+
+    // let the face know the beat engine has played at least one beat
+    if (movement_volatile_state.beat_fired) {
+        movement_volatile_state.beat_fired = false;
+        event.event_type = EVENT_BEAT;
+        event.subsecond = movement_volatile_state.beat_fired_index;
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
+    }
+
+    // the tick the face's displayed value was due to change on has come: look for the next change, and tell the
+    // face if this one is real. It may not be, if the clock was set or there was no change within the horizon.
+    if (movement_volatile_state.redraw_due) {
+        movement_volatile_state.redraw_due = false;
+        if (_movement_redraw.value_at != NULL) {
+            uint32_t value = _movement_redraw_arm();
+            if (value != _movement_redraw.value) {
+                _movement_redraw.value = value;
+                event.event_type = EVENT_VALUE_CHANGED;
+                event.subsecond = 0;
+                can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
+            }
+        }
+    }
+
     // Now handle the EVENT_TIMEOUT
     if (resign_timeout && movement_state.current_face_idx != 0) {
         event.event_type = EVENT_TIMEOUT;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
     }
 
     // The watch_face_changed flag might be set again by the face loop, so check it again
@@ -1320,14 +2528,51 @@ bool app_loop(void) {
         can_sleep = _switch_face() && can_sleep;
     }
 
+    // The first pass has drawn the first face, so bring up the rest of the watch, a step per pass. A step that is
+    // waiting has armed BOOT_TIMEOUT, so there's no need to stay awake for it.
+    if (_movement_boot.step < MOVEMENT_NUM_BOOT_STEPS) {
+        if (!_movement_boot.drawn) {
+            _movement_boot.drawn = true;
+            _movement_boot.first_pixel_counter = watch_rtc_get_counter();
+        }
+        if (_movement_run_boot_step() && _movement_boot.step < MOVEMENT_NUM_BOOT_STEPS) can_sleep = false;
+    }
+
+    // Work through queued jobs one slice per pass, so events get handled in between.
+    if (_movement_job_stats.depth) {
+        _movement_run_job_slice();
+        can_sleep = false;
+    }
+
 #ifndef MOVEMENT_LOW_ENERGY_MODE_FORBIDDEN
-    // if we have timed out of our low energy mode countdown, enter low energy mode.
-    if (movement_volatile_state.enter_sleep_mode && !movement_volatile_state.is_buzzing) {
+    // a face keeping time with the beat engine stays awake until it stops the beats or resigns.
+    if (movement_volatile_state.enter_sleep_mode && movement_volatile_state.beat_pattern != NULL) {
+        movement_volatile_state.enter_sleep_mode = false;
+        _movement_reset_inactivity_countdown();
+    }
+
+    // if we have timed out of our low energy mode countdown, enter low energy mode, once the job queue has drained.
+    if (movement_volatile_state.enter_sleep_mode && !movement_volatile_state.is_buzzing && !_movement_job_stats.depth) {
         movement_volatile_state.enter_sleep_mode = false;
         movement_volatile_state.is_sleeping = true;
 
         // No need to fire resign and sleep interrupts while in sleep mode
         _movement_disable_inactivity_countdown();
+        // Nor to keep waking up for animation frames nobody is looking at
+        movement_stop_animation();
+        // A coroutine waiting on a deadline picks up again on the first event after waking.
+        movement_coroutine_cancel_wake();
+        // The displayed value only updates once a minute now; catch it up after waking.
+        watch_rtc_disable_comp_callback_no_schedule(REDRAW_TIMEOUT);
+        movement_volatile_state.schedule_next_comp = true;
+
+#ifdef I2C_SERCOM
+        // I2C is off in low energy mode, so only listen for the light coming up, which wakes us.
+        if (movement_state.has_opt3001) {
+            _movement_light_set_window(true);
+            watch_register_extwake_callback(HAL_GPIO_A2_pin(), cb_light_sensor_interrupt, false);
+        }
+#endif
 
         watch_register_extwake_callback(HAL_GPIO_BTN_ALARM_pin(), cb_alarm_btn_extwake, true);
 
@@ -1349,6 +2594,8 @@ bool app_loop(void) {
             _pending_sequence = NULL;
         }
 
+        if (_movement_redraw.value_at != NULL) movement_volatile_state.redraw_due = true;
+
         // don't let the watch sleep when exiting deep sleep mode,
         // so that app_loop will run again and process the events that may have fired.
         can_sleep = false;
@@ -1361,6 +2608,17 @@ bool app_loop(void) {
         watch_rtc_schedule_next_comp();
     }
 
+    if (injected) {
+        _movement_injection_stats.handled_counter = watch_rtc_get_counter();
+        _movement_injection_stats.active_ticks += _movement_injection_stats.handled_counter - loop_counter;
+        _movement_injection_stats.num_loops++;
+    }
+
+    // stay awake until a burst of injected ticks has been delivered
+    if (movement_volatile_state.injected_ticks) {
+        can_sleep = false;
+    }
+
 #if __EMSCRIPTEN__
     shell_task();
 #else
@@ -1370,43 +2628,65 @@ bool app_loop(void) {
     }
 #endif
 
-    // if we are plugged into USB, we can't sleep because we need to keep the serial shell running.
+    // if we are plugged into USB, we can't enter standby, because the USB peripheral needs its clocks to keep the
+    // serial shell running. We can still halt the CPU until the next interrupt, though, unless the face asked us not to.
     if (usb_is_enabled()) {
         yield();
+#if !__EMSCRIPTEN__
+        // That goes for a suspended bus too: standby would stop the clocks the USB peripheral needs to see the host
+        // resume it, so the best we can do is halt the CPU like any other idle moment.
+        if (can_sleep) _movement_usb_idle();
+#endif
         can_sleep = false;
     }
 
     return can_sleep;
 }
 
-static movement_event_type_t _process_button_event(bool pin_level, movement_button_t* button) {
-    movement_event_type_t event_type = EVENT_NONE;
-
-    // This shouldn't happen normally
-    if (pin_level == button->is_down) {
-        return event_type;
-    }
-
-    uint32_t counter = watch_rtc_get_counter();
-
-#if MOVEMENT_DEBOUNCE_TICKS
+#if !__EMSCRIPTEN__
+static void _movement_usb_idle(void) {
+    // Check for work with interrupts masked: an interrupt that fires after the check still ends the WFI at once.
+    __disable_irq();
     if (
-        (counter - button->up_timestamp) <= MOVEMENT_DEBOUNCE_TICKS &&
-        (counter - button->down_timestamp) <= MOVEMENT_DEBOUNCE_TICKS
+        !movement_volatile_state.pending_events &&
+        !movement_volatile_state.has_pending_accelerometer &&
+        !movement_volatile_state.has_pending_light &&
+        !movement_volatile_state.beat_fired &&
+        !movement_volatile_state.redraw_due &&
+        !movement_volatile_state.minute_alarm_fired &&
+        !movement_volatile_state.timer_fired &&
+        !movement_volatile_state.turn_led_off &&
+        !movement_volatile_state.enter_sleep_mode &&
+        !movement_volatile_state.schedule_next_comp &&
+        !tud_task_event_ready() &&
+        cdc_is_idle()
     ) {
-        return event_type;
+        // IDLE sleep (2) stops the CPU but leaves every clock running, so USB transfers carry on and wake us up.
+        sleep(2);
     }
+    __enable_irq();
+}
 #endif
 
+// Timestamps an edge for movement_get_button_event_capture: from the timer capture if the button has one, otherwise
+// from the RTC counter, scaled to the same units.
+static uint32_t _movement_button_capture(movement_button_t* button, rtc_counter_t counter) {
+    if (button->is_captured) return watch_get_capture(button->pin);
+    return counter * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency());
+}
+
+static movement_event_type_t _movement_apply_button_level(bool pin_level, movement_button_t* button, rtc_counter_t counter) {
+    movement_event_type_t event_type;
+
     button->is_down = pin_level;
 
     if (pin_level) {
         button->down_timestamp = counter;
+        button->down_capture = _movement_button_capture(button, counter);
         event_type = button->down_event;
     } else {
-#if MOVEMENT_DEBOUNCE_TICKS
         button->up_timestamp = counter;
-#endif
+        button->up_capture = _movement_button_capture(button, counter);
         if ((counter - button->down_timestamp) >= MOVEMENT_REALLY_LONG_PRESS_TICKS) {
             // event_type = button->down_event + 5;
             event_type = button->down_event + 3; // TODO: swith to REALLY_LONG_UP
@@ -1420,6 +2700,85 @@ static movement_event_type_t _process_button_event(bool pin_level, movement_butt
     return event_type;
 }
 
+#if MOVEMENT_DEBOUNCE_TICKS
+static movement_button_t* const _movement_buttons[3] = {
+    &movement_volatile_state.mode_button,
+    &movement_volatile_state.light_button,
+    &movement_volatile_state.alarm_button,
+};
+
+static void _movement_schedule_button_settle(void) {
+    rtc_counter_t now = watch_rtc_get_counter();
+    movement_button_t* soonest = NULL;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        movement_button_t* button = _movement_buttons[i];
+        if (button->is_settling && (soonest == NULL || (int32_t)(button->settle_counter - soonest->settle_counter) < 0)) {
+            soonest = button;
+        }
+    }
+
+    if (soonest) {
+        rtc_counter_t counter = soonest->settle_counter;
+        if ((int32_t)(counter - now) <= 0) counter = now + 1;
+        watch_rtc_register_comp_callback_no_schedule(cb_button_settle, counter, BUTTON_SETTLE_TIMEOUT);
+    } else {
+        watch_rtc_disable_comp_callback_no_schedule(BUTTON_SETTLE_TIMEOUT);
+    }
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+// Takes the first edge as it comes, then stops listening to the button until it has had MOVEMENT_DEBOUNCE_TICKS to
+// settle. The EIC's majority filter already drops glitches shorter than a few of its clock cycles; this drops the
+// contact bounce that follows, so each bounce doesn't cost an interrupt and a wake-up.
+static void _movement_button_begin_settling(movement_button_t* button, rtc_counter_t counter) {
+    watch_mask_interrupt(button->pin);
+    button->settle_counter = counter + MOVEMENT_DEBOUNCE_TICKS;
+    button->is_settling = true;
+}
+
+// At the end of the window, the level is the truth. If it differs from the last edge, the button was released (or
+// pressed again) while we weren't listening: that's the next edge, and it gets its own window.
+static movement_event_type_t _movement_button_settle(bool pin_level, movement_button_t* button, rtc_counter_t counter) {
+    if (!button->is_settling || (int32_t)(counter - button->settle_counter) < 0) return EVENT_NONE;
+
+    button->is_settling = false;
+    // the timer captured the bounces too; the next edge should find none of them.
+    if (button->is_captured) watch_discard_capture(button->pin);
+    if (pin_level == button->is_down) {
+        watch_unmask_interrupt(button->pin);
+        return EVENT_NONE;
+    }
+
+    // this edge came while masked, so it's only known to within the settle window, like its RTC timestamp.
+    button->num_edges++;
+    _movement_button_begin_settling(button, counter);
+    return _movement_apply_button_level(pin_level, button, counter);
+}
+#endif
+
+static movement_event_type_t _process_button_event(bool pin_level, movement_button_t* button) {
+    movement_event_type_t event_type = EVENT_NONE;
+
+    button->num_interrupts++;
+
+    // This shouldn't happen normally
+    if (pin_level == button->is_down) {
+        if (button->is_captured) watch_discard_capture(button->pin);
+        return event_type;
+    }
+
+    uint32_t counter = watch_rtc_get_counter();
+    button->num_edges++;
+
+#if MOVEMENT_DEBOUNCE_TICKS
+    _movement_button_begin_settling(button, counter);
+    _movement_schedule_button_settle();
+#endif
+
+    return _movement_apply_button_level(pin_level, button, counter);
+}
+
 void cb_light_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_LIGHT_read();
 
@@ -1438,6 +2797,21 @@ void cb_alarm_btn_interrupt(void) {
     movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.alarm_button);
 }
 
+void cb_button_settle(void) {
+#if MOVEMENT_DEBOUNCE_TICKS
+    rtc_counter_t counter = watch_rtc_get_counter();
+    uint32_t events = 0;
+
+    events |= 1 << _movement_button_settle(HAL_GPIO_BTN_MODE_read() || movement_volatile_state.mode_button.is_injected, &movement_volatile_state.mode_button, counter);
+    events |= 1 << _movement_button_settle(HAL_GPIO_BTN_LIGHT_read() || movement_volatile_state.light_button.is_injected, &movement_volatile_state.light_button, counter);
+    events |= 1 << _movement_button_settle(HAL_GPIO_BTN_ALARM_read() || movement_volatile_state.alarm_button.is_injected, &movement_volatile_state.alarm_button, counter);
+
+    movement_volatile_state.pending_events |= events;
+    // we're inside the RTC interrupt, which schedules the next comp once all callbacks have run.
+    _movement_schedule_button_settle();
+#endif
+}
+
 static movement_event_type_t _process_button_longpress_timeout(bool pin_level, movement_button_t* button) {
     if (!button->is_down) {
         return EVENT_NONE;
@@ -1456,11 +2830,9 @@ static movement_event_type_t _process_button_longpress_timeout(bool pin_level, m
             return button->down_event + 2; // event_longpress
         }
     } else {
-    // hypotetical corner case: if the timeout fired but the pin level is actually up, we may have missed/rejected the up event, so fire it here
-#if MOVEMENT_DEBOUNCE_TICKS
-        // we're in a corner case, we don't know when the up actually happened.
-        button->up_timestamp = button->down_timestamp;
-#endif
+    // hypotetical corner case: if the timeout fired but the pin level is actually up, we may have missed the up event, so fire it here
+        button->up_timestamp = counter;
+        button->up_capture = counter * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency());
         button->is_down = false;
         if (max_long_press) {
             // return button->down_event + 5; // event_really_long_up
@@ -1474,22 +2846,22 @@ static movement_event_type_t _process_button_longpress_timeout(bool pin_level, m
 }
 
 void cb_light_btn_timeout_interrupt(void) {
-    bool pin_level = HAL_GPIO_BTN_LIGHT_read();
     movement_button_t* button = &movement_volatile_state.light_button;
+    bool pin_level = HAL_GPIO_BTN_LIGHT_read() || button->is_injected;
 
     movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
 }
 
 void cb_mode_btn_timeout_interrupt(void) {
-    bool pin_level = HAL_GPIO_BTN_MODE_read();
     movement_button_t* button = &movement_volatile_state.mode_button;
+    bool pin_level = HAL_GPIO_BTN_MODE_read() || button->is_injected;
 
     movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
 }
 
 void cb_alarm_btn_timeout_interrupt(void) {
-    bool pin_level = HAL_GPIO_BTN_ALARM_read();
     movement_button_t* button = &movement_volatile_state.alarm_button;
+    bool pin_level = HAL_GPIO_BTN_ALARM_read() || button->is_injected;
 
     movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
 }
@@ -1519,6 +2891,14 @@ void cb_minute_alarm_fired(void) {
 #endif
 }
 
+void cb_timer_fired(void) {
+    movement_volatile_state.timer_fired = true;
+
+#if __EMSCRIPTEN__
+    _wake_up_simulator();
+#endif
+}
+
 void cb_tick(void) {
     rtc_counter_t counter = watch_rtc_get_counter();
     uint32_t freq = watch_rtc_get_frequency();
@@ -1528,7 +2908,94 @@ void cb_tick(void) {
     movement_volatile_state.subsecond = ((counter + half_freq) & subsecond_mask) >> movement_state.tick_pern;
 }
 
+void cb_animation_frame(void) {
+    const movement_animation_t *animation = movement_volatile_state.animation;
+    if (animation == NULL) return;
+
+    uint8_t frame = movement_volatile_state.animation_frame;
+
+    if (frame >= animation->num_frames) {
+        if (!animation->loop) {
+            // The last frame has been on screen for its full duration; leave it there and let the face know.
+            movement_volatile_state.animation = NULL;
+            movement_volatile_state.pending_events |= 1 << EVENT_ANIMATION_DONE;
+            return;
+        }
+        frame = 0;
+    }
+
+    _movement_show_animation_frame(animation, frame);
+    movement_volatile_state.animation_frame = frame + 1;
+
+    // Schedule from the previous deadline rather than the current counter, so frames don't drift.
+    movement_volatile_state.animation_counter += movement_volatile_state.animation_frame_ticks;
+    // we're inside the RTC interrupt, which schedules the next comp once all callbacks have run.
+    watch_rtc_register_comp_callback_no_schedule(cb_animation_frame, movement_volatile_state.animation_counter, ANIMATION_TIMEOUT);
+}
+
+void cb_beat(void) {
+    const movement_beat_pattern_t *pattern = movement_volatile_state.beat_pattern;
+    if (pattern == NULL) return;
+
+    uint32_t late_ticks = watch_rtc_get_counter() - movement_volatile_state.beat_counter;
+    if (late_ticks > _movement_beat_stats.max_late_ticks) _movement_beat_stats.max_late_ticks = late_ticks;
+    _movement_beat_stats.num_beats++;
+
+    const movement_beat_step_t *step = &pattern->steps[movement_volatile_state.beat_step];
+    if (movement_volatile_state.beat_step_beat == 0 && (step->sequence != NULL || step->led_ticks)) {
+        movement_volatile_state.beat_cue_counter = movement_volatile_state.beat_counter;
+        movement_volatile_state.beat_cue = step;
+    }
+
+    movement_volatile_state.beat_fired_index = movement_volatile_state.beat_index;
+    movement_volatile_state.beat_fired = true;
+
+    movement_volatile_state.beat_index++;
+    movement_volatile_state.beat_step_beat++;
+    if (movement_volatile_state.beat_step_beat >= step->beats) {
+        movement_volatile_state.beat_step_beat = 0;
+        movement_volatile_state.beat_step++;
+        if (movement_volatile_state.beat_step >= pattern->num_steps) {
+            movement_volatile_state.beat_step = 0;
+            movement_volatile_state.beat_index = 0;
+        }
+    }
+
+    // Schedule from the previous deadline rather than the current counter, carrying the fractional tick over
+    // to the next beat, so beats don't drift at any tempo.
+    uint32_t counter = movement_volatile_state.beat_counter + movement_volatile_state.beat_period_ticks;
+    uint32_t error = movement_volatile_state.beat_error + movement_volatile_state.beat_period_remainder;
+    if (error >= pattern->centibeats_per_minute) {
+        error -= pattern->centibeats_per_minute;
+        counter++;
+    }
+    movement_volatile_state.beat_counter = counter;
+    movement_volatile_state.beat_error = error;
+    // we're inside the RTC interrupt, which schedules the next comp once all callbacks have run.
+    watch_rtc_register_comp_callback_no_schedule(cb_beat, counter, BEAT_TIMEOUT);
+}
+
+void cb_boot_step(void) {
+    // nothing to do but wake up: app_loop runs the boot step that was waiting.
+}
+
+void cb_coroutine(void) {
+    movement_volatile_state.pending_events |= 1 << EVENT_COROUTINE_RESUME;
+}
+
+void cb_redraw(void) {
+    movement_volatile_state.redraw_due = true;
+}
+
+void cb_light_sensor_interrupt(void) {
+    movement_volatile_state.has_pending_light = true;
+}
+
 void cb_accelerometer_event(void) {
+    // the tap happened now, not when the loop gets around to reading the interrupt source.
+    if (!movement_volatile_state.has_pending_accelerometer) {
+        movement_volatile_state.accelerometer_counter = watch_rtc_get_counter();
+    }
     movement_volatile_state.has_pending_accelerometer = true;
 }
 
@@ -1537,3 +3004,292 @@ void cb_accelerometer_wake(void) {
     // also: wake up!
     _movement_reset_inactivity_countdown();
 }
+
+// Shell commands for driving the watch from a host script: they inject events into the same pending_events
+// mask that the interrupt callbacks fill in, so app_loop handles them exactly as it would the real thing.
+
+static const char *const _movement_injectable_event_names[] = {
+    [EVENT_TICK] = "tick",
+    [EVENT_LOW_ENERGY_UPDATE] = "low_energy_update",
+    [EVENT_TIMEOUT] = "timeout",
+    [EVENT_ACCELEROMETER_WAKE] = "accelerometer_wake",
+    [EVENT_SINGLE_TAP] = "single_tap",
+    [EVENT_DOUBLE_TAP] = "double_tap",
+};
+
+static void _movement_note_injection(void) {
+    _movement_injection_stats.injected_counter = watch_rtc_get_counter();
+    _movement_injection_stats.pending = true;
+}
+
+int movement_cmd_btn(int argc, char *argv[]) {
+    (void) argc;
+
+    movement_button_t *button;
+    if (!strcmp(argv[1], "light")) {
+        button = &movement_volatile_state.light_button;
+    } else if (!strcmp(argv[1], "mode")) {
+        button = &movement_volatile_state.mode_button;
+    } else if (!strcmp(argv[1], "alarm")) {
+        button = &movement_volatile_state.alarm_button;
+    } else {
+        return -2;
+    }
+
+    bool down = !strcmp(argv[2], "down");
+    bool up = !strcmp(argv[2], "up");
+    if (!strcmp(argv[2], "press")) {
+        down = up = true;
+    } else if (!down && !up) {
+        return -2;
+    }
+
+    // Debouncing is skipped: a press is a down and an up with the same timestamp, which must read as a short press.
+    rtc_counter_t counter = watch_rtc_get_counter();
+    uint32_t events = 0;
+    if (down && !button->is_down) {
+        button->is_injected = true;
+        events |= 1 << _movement_apply_button_level(true, button, counter);
+    }
+    if (up && button->is_down) {
+        button->is_injected = false;
+        events |= 1 << _movement_apply_button_level(false, button, counter);
+    }
+
+    movement_volatile_state.pending_events |= events;
+    _movement_note_injection();
+
+    return 0;
+}
+
+int movement_cmd_inject(int argc, char *argv[]) {
+    uint8_t event_type = EVENT_NONE;
+    for (uint8_t i = 0; i < sizeof(_movement_injectable_event_names) / sizeof(_movement_injectable_event_names[0]); i++) {
+        if (_movement_injectable_event_names[i] && !strcmp(argv[1], _movement_injectable_event_names[i])) {
+            event_type = i;
+            break;
+        }
+    }
+    if (event_type == EVENT_NONE) {
+        // buttons have state of their own and go through the btn command
+        char *end;
+        long value = strtol(argv[1], &end, 0);
+        if (*end || value <= EVENT_NONE || value >= EVENT_NUM_EVENTS || (_movement_button_events_mask & (1UL << value))) {
+            return -2;
+        }
+        event_type = value;
+    }
+
+    long count = 1;
+    if (argc >= 3) {
+        count = strtol(argv[2], NULL, 0);
+        if (count < 1 || count > UINT16_MAX) return -2;
+    }
+
+    if (event_type == EVENT_TICK) {
+        // The mask can only hold one of each event, so a burst of ticks is handed out one per app_loop pass.
+        uint32_t ticks = movement_volatile_state.injected_ticks + count;
+        movement_volatile_state.injected_ticks = ticks > UINT16_MAX ? UINT16_MAX : ticks;
+    } else {
+        movement_volatile_state.pending_events |= 1 << event_type;
+    }
+    _movement_note_injection();
+
+    return 0;
+}
+
+int movement_cmd_lcd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    // one line per common pin, with bit n set if segment pin n is on.
+    uint8_t num_coms = watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM ? 4 : 3;
+    for (uint8_t com = 0; com < num_coms; com++) {
+        uint32_t segments = 0;
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if (watch_get_pixel(com, seg)) segments |= 1UL << seg;
+        }
+        printf("com%d,0x%08lx\r\n", com, (unsigned long)segments);
+    }
+
+    return 0;
+}
+
+int movement_cmd_timing(int argc, char *argv[]) {
+    if (argc >= 2) {
+        if (strcmp(argv[1], "reset")) return -2;
+        memset(&_movement_injection_stats, 0, sizeof(_movement_injection_stats));
+        return 0;
+    }
+
+    // all counters are RTC ticks; a host script can divide by the frequency to get seconds.
+    movement_injection_stats_t stats = _movement_injection_stats;
+    printf("face,frequency,counter,injected,handled,latency,active,loops\r\n");
+    printf("%d,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+        movement_state.current_face_idx,
+        (unsigned long)watch_rtc_get_frequency(),
+        (unsigned long)watch_rtc_get_counter(),
+        (unsigned long)stats.injected_counter,
+        (unsigned long)stats.handled_counter,
+        (unsigned long)(stats.pending ? 0 : stats.handled_counter - stats.injected_counter),
+        (unsigned long)stats.active_ticks,
+        (unsigned long)stats.num_loops);
+
+    return 0;
+}
+
+int movement_cmd_burst(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    movement_burst_stats_t stats = movement_get_burst_stats();
+    printf("bursts,refused,last_ticks,last_uj,total_ticks,total_uj,vcc_mv\r\n");
+    printf("%lu,%lu,%lu,%lu,%lu,%lu,%u\r\n",
+        (unsigned long)stats.num_bursts,
+        (unsigned long)stats.num_refused,
+        (unsigned long)stats.last_ticks,
+        (unsigned long)stats.last_energy_uj,
+        (unsigned long)stats.total_ticks,
+        (unsigned long)stats.total_energy_uj,
+        _movement_burst.vcc);
+
+    return 0;
+}
+
+int movement_cmd_beats(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    const movement_beat_pattern_t *pattern = movement_volatile_state.beat_pattern;
+    if (pattern == NULL) {
+        printf("no beats running\r\n");
+        return 0;
+    }
+
+    // The beats whose deadlines have passed since the first one, against the beats the engine has actually played.
+    // Beat n is due at floor(n * period) ticks, so that is every n below (elapsed + 1) / period.
+    rtc_counter_t elapsed_ticks = watch_rtc_get_counter() - _movement_beat_stats.start_counter;
+    uint64_t ticks_per_minute_x100 = 6000 * watch_rtc_get_frequency();
+    uint64_t expected = ((uint64_t)(elapsed_ticks + 1) * pattern->centibeats_per_minute + ticks_per_minute_x100 - 1) / ticks_per_minute_x100;
+    printf("cbpm,elapsed_ticks,expected,played,drift,max_late_ticks\r\n");
+    printf("%lu,%lu,%lu,%lu,%ld,%lu\r\n",
+        (unsigned long)pattern->centibeats_per_minute,
+        (unsigned long)elapsed_ticks,
+        (unsigned long)expected,
+        (unsigned long)_movement_beat_stats.num_beats,
+        (long)_movement_beat_stats.num_beats - (long)expected,
+        (unsigned long)_movement_beat_stats.max_late_ticks);
+
+    return 0;
+}
+
+int movement_cmd_light(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    if (!movement_state.has_opt3001) {
+        printf("no light sensor\r\n");
+        return 0;
+    }
+
+    // A polled light sensor would have woken the watch once a second over the same time.
+    uint32_t elapsed_s = (watch_rtc_get_counter() - _movement_light.start_counter) / watch_rtc_get_frequency();
+    printf("band,centilux,interrupts,changes,elapsed_s\r\n");
+    printf("%u,%lu,%lu,%lu,%lu\r\n",
+        _movement_light.band,
+        (unsigned long)_movement_light.centilux,
+        (unsigned long)_movement_light.num_interrupts,
+        (unsigned long)_movement_light.num_changes,
+        (unsigned long)elapsed_s);
+
+    return 0;
+}
+
+int movement_cmd_jobs(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    uint32_t freq = watch_rtc_get_frequency();
+    printf("depth,max_depth,submitted,completed,late,slices,steps,overruns,max_slice_ms\r\n");
+    printf("%u,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+        _movement_job_stats.depth,
+        _movement_job_stats.max_depth,
+        (unsigned long)_movement_job_stats.num_submitted,
+        (unsigned long)_movement_job_stats.num_completed,
+        (unsigned long)_movement_job_stats.num_late,
+        (unsigned long)_movement_job_stats.num_slices,
+        (unsigned long)_movement_job_stats.num_steps,
+        (unsigned long)_movement_job_stats.num_overruns,
+        (unsigned long)((_movement_job_stats.max_slice_ticks * 1000 + freq / 2) / freq));
+
+    return 0;
+}
+
+int movement_cmd_boot(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t ready_ticks = _movement_boot.step == MOVEMENT_NUM_BOOT_STEPS ? _movement_boot.ready_counter - _movement_boot.init_counter : 0;
+    printf("first_pixel_ms,ready_ms\r\n");
+    printf("%lu,%lu\r\n",
+        (unsigned long)((_movement_boot.first_pixel_counter - _movement_boot.init_counter) * 1000 / freq),
+        (unsigned long)(ready_ticks * 1000 / freq));
+
+    printf("step,ms\r\n");
+    for (uint8_t i = 0; i < MOVEMENT_NUM_BOOT_STEPS; i++) {
+        printf("%s,%lu\r\n", _movement_boot_steps[i].name, (unsigned long)(_movement_boot.step_ticks[i] * 1000 / freq));
+    }
+
+    return 0;
+}
+
+int movement_cmd_buttons(int argc, char *argv[]) {
+    static const char *names[3] = { "mode", "light", "alarm" };
+    movement_button_t* buttons[3] = {
+        &movement_volatile_state.mode_button,
+        &movement_volatile_state.light_button,
+        &movement_volatile_state.alarm_button,
+    };
+
+    printf("button,interrupts,edges\r\n");
+    for (uint8_t i = 0; i < 3; i++) {
+        printf("%s,%lu,%lu\r\n", names[i], (unsigned long)buttons[i]->num_interrupts, (unsigned long)buttons[i]->num_edges);
+        if (argc > 1 && !strcmp(argv[1], "reset")) {
+            buttons[i]->num_interrupts = 0;
+            buttons[i]->num_edges = 0;
+        }
+    }
+
+    return 0;
+}
+
+int movement_cmd_stack(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+#if __EMSCRIPTEN__
+    printf("no stack profile in the simulator\r\n");
+#else
+    uint32_t *lowest = _movement_stack_lowest_used(&_sstack);
+    printf("size,peak,free\r\n");
+    printf("%u,%u,%u\r\n",
+        (unsigned)((uint8_t *)&_estack - (uint8_t *)&_sstack),
+        (unsigned)((uint8_t *)&_estack - (uint8_t *)lowest),
+        (unsigned)((uint8_t *)lowest - (uint8_t *)&_sstack));
+
+#ifdef MOVEMENT_STACK_PROFILING
+    printf("face,peak\r\n");
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        if (_movement_stack.face_bytes[i]) printf("%u,%u\r\n", i, _movement_stack.face_bytes[i]);
+    }
+
+    printf("event,peak\r\n");
+    for (uint8_t i = 0; i < EVENT_NUM_EVENTS; i++) {
+        if (_movement_stack.event_bytes[i]) printf("%u,%u\r\n", i, _movement_stack.event_bytes[i]);
+    }
+#endif
+#endif
+
+    return 0;
+}
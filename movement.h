@@ -139,6 +139,15 @@ typedef enum {
     EVENT_ACCELEROMETER_WAKE,   // The accelerometer has detected motion and woken up.
     EVENT_SINGLE_TAP,           // Accelerometer detected a single tap. This event is not yet implemented.
     EVENT_DOUBLE_TAP,           // Accelerometer detected a double tap. This event is not yet implemented.
+    EVENT_ANIMATION_DONE,       // The animation started with movement_play_animation has shown its last frame.
+    EVENT_TIMER_EXPIRED,        // A countdown started with movement_timer_start has reached its target. event.subsecond holds the timer id. You may not be in the foreground.
+    EVENT_BEAT,                 // The beat engine started with movement_start_beats has played a beat. event.subsecond holds its index in the pattern.
+    EVENT_LIGHT_BAND_CHANGED,   // The ambient light moved to another movement_light_band_t, held in event.subsecond. Only sent to faces that subscribed with movement_light_subscribe; you may not be in the foreground.
+    EVENT_COROUTINE_RESUME,     // A deadline or buzzer that a movement_coroutine_t was waiting on has come; pass it to the coroutine.
+    EVENT_JOB_DONE,             // A job submitted with movement_job_submit has finished. event.subsecond holds the job id. You may not be in the foreground.
+    EVENT_VALUE_CHANGED,        // The value passed to movement_redraw_on_change has changed; movement_redraw_get_value returns it.
+
+    EVENT_NUM_EVENTS,           // Not an event: the number of event types. New events go above this line.
 } movement_event_type_t;
 
 // Each different timeout type will use a different index when invoking watch_rtc_register_comp_callback
@@ -150,6 +159,13 @@ typedef enum {
     RESIGN_TIMEOUT,             // Resign active face timeout
     SLEEP_TIMEOUT,              // Low-energy begin timeout
     MINUTE_TIMEOUT,             // Top of the Minute timeout
+    ANIMATION_TIMEOUT,          // Next display animation frame
+    TIMER_TIMEOUT,              // Soonest countdown of the timer service
+    BEAT_TIMEOUT,               // Next beat of the beat engine
+    COROUTINE_TIMEOUT,          // Deadline of the foreground face's coroutine
+    REDRAW_TIMEOUT,             // Next change of the foreground face's displayed value
+    BUTTON_SETTLE_TIMEOUT,      // End of the soonest button debounce window, see MOVEMENT_DEBOUNCE_TICKS
+    BOOT_TIMEOUT,               // When a waiting boot step can go on
 } movement_timeout_index_t;
 
 typedef enum {
@@ -163,6 +179,129 @@ typedef struct {
     uint8_t subsecond;
 } movement_event_t;
 
+/// A single pixel of the LCD, addressed by its COM and SEG lines.
+typedef struct {
+    uint8_t com;
+    uint8_t seg;
+} movement_segment_t;
+
+/** @brief A keyframe animation that Movement can play on the display without waking the watch face.
+  * @details segments lists every pixel the animation touches (up to 32). Each entry in frames is a bitmask
+  *          over that list: if bit n is set, segments[n] is lit during that frame, otherwise it is cleared.
+  *          Pixels that are not in the list are left alone, so a face can animate one corner of the display
+  *          while the rest of it stays put. Frames are advanced from an RTC compare interrupt, so the watch
+  *          sleeps between frames instead of running the face loop at a fast tick rate.
+  */
+typedef struct {
+    const movement_segment_t *segments;
+    uint8_t num_segments;
+    const uint32_t *frames;
+    uint8_t num_frames;
+    uint16_t frame_duration_ms; // how long each frame stays on screen; rounded to the nearest 1/128 s.
+    bool loop;                  // if false, the face receives EVENT_ANIMATION_DONE after the last frame.
+} movement_animation_t;
+
+/** @brief One step of a beat pattern: the cues played on its first beat, and how many beats it lasts.
+  * @details The cues are started from the main loop as soon as it sees the beat, before the face gets EVENT_BEAT;
+  *          the LED goes off led_ticks after the beat itself. Leave sequence NULL for a silent step, and led_ticks
+  *          at 0 for a dark one.
+  */
+typedef struct {
+    uint8_t beats;              // at least 1
+    int8_t *sequence;           // buzzer sequence, in the format of movement_play_sequence
+    uint8_t led_red;
+    uint8_t led_green;
+    uint8_t led_blue;
+    uint8_t led_ticks;          // how long the LED stays lit, in 1/128 s
+} movement_beat_step_t;
+
+/** @brief A repeating pattern of beats for movement_start_beats.
+  * @details The tempo is in hundredths of a beat per minute, so 6000 is one beat per second. Beat n always falls
+  *          on the RTC tick at or just before n beat periods after the first one: the remainder of each period
+  *          is carried over to the next, so any tempo keeps time over hours with at most one tick of jitter.
+  *          A pattern covers at most 255 beats.
+  */
+typedef struct {
+    uint32_t centibeats_per_minute;
+    const movement_beat_step_t *steps;
+    uint8_t num_steps;
+} movement_beat_pattern_t;
+
+/** @brief State of a stackless coroutine, for faces that play sequences, animate or wait on the player.
+  * @details A coroutine is a function of the form
+  *              static movement_coroutine_status_t _my_face_game(movement_coroutine_t *co, movement_event_t event, ...) {
+  *                  MOVEMENT_CO_BEGIN(co, event);
+  *                  ...
+  *                  MOVEMENT_CO_END(co);
+  *              }
+  *          that the face calls from its loop with every event it gets. Each MOVEMENT_CO_AWAIT_* returns to the
+  *          face until its condition holds, and arms only the wake source it needs: an RTC compare for a deadline,
+  *          the buzzer's stop callback, or nothing at all for buttons. Movement sends EVENT_COROUTINE_RESUME when
+  *          a deadline passes or the buzzer goes quiet, so the face can stay at 1 Hz and the watch sleeps in between.
+  *          Local variables don't survive an await: keep anything you need across one in the face's state. Only
+  *          one await may sit on each source line, and the body must not contain a switch statement of its own.
+  *          Movement cancels the pending wake when the face resigns, but the coroutine keeps its place; call
+  *          MOVEMENT_CO_RESET to start over.
+  */
+typedef struct {
+    uint16_t line;              // where to resume; 0 for the top
+    bool timed_out;             // set by MOVEMENT_CO_AWAIT_BUTTON_OR_TICKS if no button came before the deadline
+    rtc_counter_t deadline;     // of the pending await, if it has one
+    movement_event_t event;     // the event the coroutine was last resumed with
+} movement_coroutine_t;
+
+typedef enum {
+    MOVEMENT_COROUTINE_WAITING = 0,
+    MOVEMENT_COROUTINE_DONE,
+} movement_coroutine_status_t;
+
+#define MOVEMENT_CO_BEGIN(co, ev) (co)->event = (ev); switch ((co)->line) { case 0:
+
+#define MOVEMENT_CO_END(co) } movement_coroutine_cancel_wake(); (co)->line = 0; return MOVEMENT_COROUTINE_DONE
+
+#define MOVEMENT_CO_RESET(co) do { movement_coroutine_cancel_wake(); (co)->line = 0; } while (0)
+
+// Suspends until cond is true. The condition is checked at once, and again on every event.
+#define MOVEMENT_CO_WAIT_UNTIL(co, cond) do { \
+    (co)->line = __LINE__; __attribute__((fallthrough)); case __LINE__: \
+    if (!(cond)) return MOVEMENT_COROUTINE_WAITING; \
+} while (0)
+
+// Suspends until the RTC counter reaches counter.
+#define MOVEMENT_CO_AWAIT_DEADLINE(co, counter) do { \
+    (co)->deadline = (counter); \
+    movement_coroutine_wake_at((co)->deadline); \
+    MOVEMENT_CO_WAIT_UNTIL(co, movement_coroutine_deadline_passed((co)->deadline)); \
+} while (0)
+
+// Suspends for a number of 1/128 s RTC ticks.
+#define MOVEMENT_CO_AWAIT_TICKS(co, ticks) MOVEMENT_CO_AWAIT_DEADLINE(co, watch_rtc_get_counter() + (ticks))
+
+#define MOVEMENT_CO_AWAIT_MS(co, ms) MOVEMENT_CO_AWAIT_TICKS(co, movement_coroutine_ms_to_ticks(ms))
+
+// Suspends until the face receives one of the event types in mask, a bitmask of (1 << EVENT_...). The event that
+// resumed the coroutine is in (co)->event. Events that arrived before the await don't count.
+#define MOVEMENT_CO_AWAIT_BUTTON(co, mask) do { \
+    (co)->event.event_type = EVENT_NONE; \
+    MOVEMENT_CO_WAIT_UNTIL(co, (1UL << (co)->event.event_type) & (mask)); \
+} while (0)
+
+// As MOVEMENT_CO_AWAIT_BUTTON, but gives up after a number of RTC ticks and sets (co)->timed_out.
+#define MOVEMENT_CO_AWAIT_BUTTON_OR_TICKS(co, mask, ticks) do { \
+    (co)->deadline = watch_rtc_get_counter() + (ticks); \
+    movement_coroutine_wake_at((co)->deadline); \
+    (co)->event.event_type = EVENT_NONE; \
+    MOVEMENT_CO_WAIT_UNTIL(co, ((1UL << (co)->event.event_type) & (mask)) || movement_coroutine_deadline_passed((co)->deadline)); \
+    (co)->timed_out = !((1UL << (co)->event.event_type) & (mask)); \
+    movement_coroutine_cancel_wake(); \
+} while (0)
+
+// Suspends until the buzzer has finished playing; carries on at once if it is quiet.
+#define MOVEMENT_CO_AWAIT_BUZZER(co) do { \
+    movement_coroutine_wake_on_buzzer(); \
+    MOVEMENT_CO_WAIT_UNTIL(co, !movement_buzzer_is_playing()); \
+} while (0)
+
 extern const int16_t movement_timezone_offsets[];
 
 /** @brief Perform setup for your watch face.
@@ -295,6 +434,8 @@ typedef struct {
 
     // boolean set if accelerometer is detected
     bool has_lis2dw;
+    // boolean set if the OPT3001 ambient light sensor is detected
+    bool has_opt3001;
     // data rate for background accelerometer sensing
     lis2dw_data_rate_t accelerometer_background_rate;
     // threshold for considering the wearer is in motion
@@ -305,6 +446,24 @@ typedef struct {
     watch_buzzer_volume_t alarm_volume;
 } movement_state_t;
 
+// Returns the RTC counter captured in the button interrupt, at the edge that produced the given button event:
+// the release edge for UP and LONG_UP events, the press edge for all others. Faces that time button presses should
+// use this rather than reading watch_rtc_get_counter() in their loop, which adds the wake-up and dispatch latency.
+// For EVENT_SINGLE_TAP and EVENT_DOUBLE_TAP, it returns the counter captured in the accelerometer interrupt, and for
+// other events, the current counter.
+rtc_counter_t movement_get_button_event_counter(movement_event_type_t event_type);
+
+// Like movement_get_button_event_counter, but in 1/WATCH_CAPTURE_HZ seconds. While button capture is enabled, the
+// light and alarm buttons are timestamped by a hardware timer at the edge itself, to about a millisecond; otherwise,
+// and for the mode button, this is the RTC counter scaled to the same units.
+uint32_t movement_get_button_event_capture(movement_event_type_t event_type);
+
+// Starts hardware capture of the light and alarm button edges, for faces that time button presses to better than
+// the RTC's 1/128 second. It keeps two timers running in standby, so turn it off in resign.
+// Returns false if capture is not available, in which case movement_get_button_event_capture falls back to the RTC.
+bool movement_enable_button_capture(void);
+void movement_disable_button_capture(void);
+
 void movement_move_to_face(uint8_t watch_face_index);
 void movement_move_to_next_face(void);
 
@@ -314,8 +473,46 @@ void movement_illuminate_led(void);
 void movement_force_led_on(uint8_t red, uint8_t green, uint8_t blue);
 void movement_force_led_off(void);
 
+// Asks for EVENT_TICK at freq Hz, a power of two up to 128. 0 turns the face's ticks off altogether, for faces that
+// only wake for buttons, timers or movement_redraw_on_change. Movement goes back to 1 Hz on every face change.
 void movement_request_tick_frequency(uint8_t freq);
 
+// Plays a keyframe animation on the display, replacing any animation that is already running.
+// The animation struct (and the arrays it points to) must stay valid until it finishes or is stopped,
+// so declare it static const. Movement stops the animation when the face resigns or the watch goes to sleep.
+void movement_play_animation(const movement_animation_t *animation);
+void movement_stop_animation(void);
+bool movement_animation_is_running(void);
+
+// Starts playing a beat pattern, replacing any pattern that is already running. The first beat falls on the next
+// RTC tick. The face receives EVENT_BEAT after each beat, but it may see only the latest one if it falls behind.
+// The pattern (and its steps and sequences) must stay valid until it is stopped, so declare it static const.
+// Movement stops the beats when the face resigns, and doesn't enter low energy mode while they are running, so cues
+// that have to carry on in the background, like interval_face's phase changes, belong in background tasks instead.
+void movement_start_beats(const movement_beat_pattern_t *pattern);
+void movement_stop_beats(void);
+bool movement_beats_are_running(void);
+
+// Support for the MOVEMENT_CO_* macros. Each face has one coroutine wake at most: arming another replaces it.
+void movement_coroutine_wake_at(rtc_counter_t counter);
+void movement_coroutine_wake_on_buzzer(void);
+void movement_coroutine_cancel_wake(void);
+bool movement_coroutine_deadline_passed(rtc_counter_t deadline);
+uint32_t movement_coroutine_ms_to_ticks(uint32_t ms);
+bool movement_buzzer_is_playing(void);
+
+// Redraw on change, for faces that show a value derived from the time at a finer or odder grain than the tick:
+// decimal time, .beats and the like. The face gives Movement a function that maps a moment (UTC seconds, and 1/128
+// second ticks since it began) to the value it displays. Movement works out the RTC tick on which that value next
+// changes and wakes for it alone, then sends EVENT_VALUE_CHANGED; the face redraws once per visible change and does
+// nothing on the ticks in between. The function must be cheap and pure, since Movement calls it a couple of dozen
+// times to find each change. Movement stops tracking when the face resigns, and in low energy mode.
+typedef uint32_t (*movement_display_value_t)(uint32_t timestamp, uint32_t ticks, void *context);
+void movement_redraw_on_change(movement_display_value_t value_at, void *context);
+void movement_redraw_cancel(void);
+// Returns the value as of the last call to movement_redraw_on_change or EVENT_VALUE_CHANGED.
+uint32_t movement_redraw_get_value(void);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time_t date_time);
@@ -328,11 +525,45 @@ void movement_cancel_background_task(void);
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+// Movement timer service. Faces run countdowns against absolute UTC timestamps, each one named by the owning face's
+// index and a timer id (0-7) of the face's choosing. Movement keeps a single RTC compare armed for the soonest target,
+// so running countdowns cost one wake-up per expiry and nothing in between, in low energy mode too. On expiry, the
+// owning face's loop is called with EVENT_TIMER_EXPIRED, whether or not it is in the foreground.
+// The first MOVEMENT_NUM_PERSISTENT_TIMERS slots are mirrored to backup registers, so countdowns ending within ~190
+// days survive a reset; a face can pick them up again in setup with movement_timer_is_running.
+// Returns false if the id is out of range, the target is not in the future or all MOVEMENT_NUM_TIMERS slots are in use.
+// Starting a timer that is already running moves its target.
+bool movement_timer_start(uint8_t watch_face_index, uint8_t timer_id, uint32_t target_timestamp);
+void movement_timer_cancel(uint8_t watch_face_index, uint8_t timer_id);
+bool movement_timer_is_running(uint8_t watch_face_index, uint8_t timer_id);
+// Returns the UTC target of the timer, or 0 if it is not running.
+uint32_t movement_timer_get_target(uint8_t watch_face_index, uint8_t timer_id);
+// Returns the number of seconds left on the timer, or 0 if it is not running.
+uint32_t movement_timer_get_remaining(uint8_t watch_face_index, uint8_t timer_id);
+// Renders a number of seconds as "HHMMSS" for WATCH_POSITION_BOTTOM, with the hours space padded and capped at 99.
+// buf must have room for 7 characters.
+void movement_timer_format_remaining(char *buf, uint32_t seconds);
+
+// Movement job executor, for computations too long to run inside a face's loop without holding up the buttons.
+// The face splits the work into a step function that does a small piece of it on each call and returns true once
+// it has finished. Between events, Movement runs the queued jobs in slices of about MOVEMENT_JOB_SLICE_MS, earliest
+// deadline first, and keeps the watch awake (and out of low energy mode) until the queue is empty. When a job
+// finishes, the submitting face's loop is called with EVENT_JOB_DONE, whether or not it is in the foreground.
+// deadline_ms only orders the jobs: a job that misses it still runs to completion, and is counted as late.
+// Job ids are the face's choice (0-7). Returns false if the face index or id is out of range, or all MOVEMENT_NUM_JOBS
+// slots are in use. Submitting a job that is already queued starts it over with the new step function and context.
+typedef bool (*movement_job_step_t)(void *context);
+bool movement_job_submit(uint8_t watch_face_index, uint8_t job_id, movement_job_step_t step, void *context, uint32_t deadline_ms);
+void movement_job_cancel(uint8_t watch_face_index, uint8_t job_id);
+bool movement_job_is_queued(uint8_t watch_face_index, uint8_t job_id);
+
 void movement_request_sleep(void);
 void movement_request_wake(void);
 
 void movement_play_note(watch_buzzer_note_t note, uint16_t duration_ms);
 void movement_play_signal(void);
+// True during the quiet hours set by MOVEMENT_QUIET_HOURS_START and _END, when scheduled signals should stay silent.
+bool movement_in_quiet_hours(void);
 void movement_play_alarm(void);
 void movement_play_alarm_beeps(uint8_t rounds, watch_buzzer_note_t alarm_note);
 void movement_play_sequence(int8_t *note_sequence, movement_buzzer_priority_t priority);
@@ -408,3 +639,53 @@ bool movement_set_accelerometer_motion_threshold(uint8_t new_threshold);
 // If the board has multiple temperature sensors, it will use the most accurate one available.
 // If the board has no temperature sensors, it will return 0xFFFFFFFF.
 float movement_get_temperature(void);
+
+// Ambient light service. If an OPT3001 is fitted, Movement keeps it converting in the background and has it raise
+// an interrupt only when the light crosses into another band, so nothing polls the sensor. The bands overlap a
+// little so that light hovering at an edge doesn't flip back and forth. Movement itself skips the LED in daylight,
+// and wakes from low energy mode when the light comes up from dark (lights on, or the watch out of a sleeve).
+typedef enum {
+    MOVEMENT_LIGHT_BAND_DARK = 0,   // below 8 to 12 lux: a dark room, or under a sleeve
+    MOVEMENT_LIGHT_BAND_INDOOR,     // ordinary indoor lighting
+    MOVEMENT_LIGHT_BAND_DAYLIGHT,   // above 1600 to 2500 lux: outdoors
+} movement_light_band_t;
+
+// Returns MOVEMENT_LIGHT_BAND_INDOOR if there is no light sensor.
+movement_light_band_t movement_get_light_band(void);
+// The reading that placed us in the current band, in hundredths of a lux, or 0 if there is no light sensor.
+uint32_t movement_get_light_centilux(void);
+// A subscribed face receives EVENT_LIGHT_BAND_CHANGED whenever the band changes, even in the background.
+void movement_light_subscribe(uint8_t watch_face_index, bool subscribe);
+
+// Performance bursts: before a heavy computation (hashing, astronomy, a game search), a face can have the CPU run at
+// 16 MHz instead of 4 MHz until it is done. Finishing sooner means going back to sleep sooner, which usually costs
+// less energy overall. Bursts nest, and the CPU slows down when the outermost one ends. If the battery is too low
+// to supply the extra current, the CPU stays at 4 MHz and movement_begin_performance_burst returns false; call
+// movement_end_performance_burst either way. Don't play the buzzer or use I2C or SPI during a burst.
+bool movement_begin_performance_burst(void);
+void movement_end_performance_burst(void);
+
+typedef struct {
+    uint32_t num_bursts;        // bursts that ran at 16 MHz
+    uint32_t num_refused;       // bursts that stayed at 4 MHz because the battery was low
+    uint32_t last_ticks;        // RTC ticks the last burst lasted
+    uint32_t last_energy_uj;    // estimated energy of the last burst, in microjoules
+    uint32_t total_ticks;
+    uint32_t total_energy_uj;
+} movement_burst_stats_t;
+
+movement_burst_stats_t movement_get_burst_stats(void);
+
+// Shell commands for automated testing over USB: inject button presses and other events into app_loop,
+// read back the display segments, and report how long the watch took to handle the injected events.
+int movement_cmd_btn(int argc, char *argv[]);
+int movement_cmd_inject(int argc, char *argv[]);
+int movement_cmd_lcd(int argc, char *argv[]);
+int movement_cmd_timing(int argc, char *argv[]);
+int movement_cmd_burst(int argc, char *argv[]);
+int movement_cmd_beats(int argc, char *argv[]);
+int movement_cmd_light(int argc, char *argv[]);
+int movement_cmd_jobs(int argc, char *argv[]);
+int movement_cmd_stack(int argc, char *argv[]);
+int movement_cmd_buttons(int argc, char *argv[]);
+int movement_cmd_boot(int argc, char *argv[]);
@@ -54,6 +54,13 @@ const watch_face_t watch_faces[] = {
 /* Custom hourly chime tune. Check movement_custom_signal_tunes.h for options. */
 #define SIGNAL_TUNE_DEFAULT
 
+/* Quiet hours: from the start hour up to the end hour (0-23, local time), the
+ * hourly chime and other scheduled signals stay silent. The window may wrap
+ * past midnight, e.g. 22 and 7. Set both to the same hour to chime around the clock.
+ */
+#define MOVEMENT_QUIET_HOURS_START 0
+#define MOVEMENT_QUIET_HOURS_END 0
+
 /* Determines the intensity of the led colors
  * Set a hex value 0-15 with 0x0 being off and 0xF being max intensity
  */
@@ -104,8 +111,17 @@ const watch_face_t watch_faces[] = {
 
 /* Optionally debounce button presses (disable by default).
  * A value of 4 is a good starting point if you have issues
- * with multiple button presses firing.
+ * with multiple button presses firing. Each edge masks the
+ * button's interrupt for this many ticks (1/128 s), so the
+ * bounce that follows doesn't wake the watch; the shell's
+ * buttons command counts the interrupts this saves.
 */
 #define MOVEMENT_DEBOUNCE_TICKS 0
 
+/* Uncomment to have the shell's stack command break the deepest stack use down
+ * by face and event type. That repaints and rescans the used part of the stack
+ * around every face loop call, so leave it off outside of debugging builds.
+ */
+// #define MOVEMENT_STACK_PROFILING
+
 #endif // MOVEMENT_CONFIG_H_
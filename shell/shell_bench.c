@@ -0,0 +1,269 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "shell_bench.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "watch.h"
+#include "watch_utility.h"
+#include "movement.h"
+#include "filesystem.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
+#include "TOTP.h"
+#include "sunriset.h"
+#include "lis2dw.h"
+#include "spectrum.h"
+
+#define BENCH_DEFAULT_TICKS (128)
+#define BENCH_FILENAME "bench.tmp"
+
+typedef struct {
+    const char *name;
+    bool (*setup)(void);        // optional; return false to skip the benchmark
+    void (*run)(uint32_t iteration);
+    void (*teardown)(void);     // optional
+    uint16_t ops_per_run;       // fast operations are batched so the counter read doesn't dominate
+    uint16_t max_runs;          // 0 for no limit other than time
+    bool uses_cpu_clock;        // drives a peripheral clocked with the CPU, so it can't run in a performance burst
+} bench_t;
+
+static uint8_t _bench_data[128];
+static volatile uint32_t _bench_sink;
+
+static bool _bench_setup_data(void) {
+    for (uint8_t i = 0; i < sizeof(_bench_data); i++) {
+        _bench_data[i] = i * 7 + 1;
+    }
+    return true;
+}
+
+static void _bench_sha1(uint32_t iteration) {
+    (void) iteration;
+    static mbedtls_sha1_context ctx;
+    mbedtls_sha1_process(&ctx, _bench_data);
+    _bench_sink = ctx.state[0];
+}
+
+static void _bench_sha256(uint32_t iteration) {
+    (void) iteration;
+    static mbedtls_sha256_context ctx;
+    mbedtls_sha256_process(&ctx, _bench_data);
+    _bench_sink = ctx.state[0];
+}
+
+static void _bench_sha512(uint32_t iteration) {
+    (void) iteration;
+    static mbedtls_sha512_context ctx;
+    mbedtls_sha512_process(&ctx, _bench_data);
+    _bench_sink = (uint32_t)ctx.state[0];
+}
+
+static bool _bench_setup_totp(void) {
+    // Note that this replaces the key of the TOTP library; the TOTP faces set it again when they are activated.
+    _bench_setup_data();
+    TOTP(_bench_data, 20, 30, SHA1);
+    return true;
+}
+
+static void _bench_totp(uint32_t iteration) {
+    _bench_sink = getCodeFromTimestamp(1700000000 + iteration * 30);
+}
+
+static void _bench_display(uint32_t iteration) {
+    watch_display_text(WATCH_POSITION_FULL, (iteration & 1) ? "WE12123456" : "TH31888888");
+}
+
+static void _bench_display_teardown(void) {
+    // Faces that only redraw what changed will not fully repaint on their own; `inject 1` sends an EVENT_ACTIVATE.
+    watch_clear_display();
+}
+
+static void _bench_fs_write(uint32_t iteration) {
+    (void) iteration;
+    filesystem_write_file(BENCH_FILENAME, (char *)_bench_data, 64);
+}
+
+static bool _bench_setup_fs_read(void) {
+    _bench_setup_data();
+    return filesystem_write_file(BENCH_FILENAME, (char *)_bench_data, 64);
+}
+
+static void _bench_fs_read(uint32_t iteration) {
+    (void) iteration;
+    char buf[64];
+    filesystem_read_file(BENCH_FILENAME, buf, sizeof(buf));
+    _bench_sink = buf[0];
+}
+
+static bool _bench_setup_fs_append(void) {
+    _bench_setup_data();
+    return filesystem_write_file(BENCH_FILENAME, "", 0);
+}
+
+static void _bench_fs_append(uint32_t iteration) {
+    (void) iteration;
+    filesystem_append_file(BENCH_FILENAME, (char *)_bench_data, 16);
+}
+
+static void _bench_fs_teardown(void) {
+    filesystem_rm(BENCH_FILENAME);
+}
+
+static bool _bench_setup_i2c(void) {
+#ifdef I2C_SERCOM
+    watch_enable_i2c();
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WHO_AM_I) == LIS2DW_WHO_AM_I_VAL;
+#else
+    return false;
+#endif
+}
+
+static void _bench_i2c(uint32_t iteration) {
+    (void) iteration;
+#ifdef I2C_SERCOM
+    _bench_sink = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WHO_AM_I);
+#endif
+}
+
+static void _bench_unix_time(uint32_t iteration) {
+    // one round trip through the calendar per op, a little over a day apart each time.
+    for (uint8_t i = 0; i < 16; i++) {
+        uint32_t timestamp = 1700000000 + (iteration * 16 + i) * 90061;
+        watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
+        _bench_sink = watch_utility_date_time_to_unix_time(date_time, 0);
+    }
+}
+
+static void _bench_sunrise(uint32_t iteration) {
+    double rise, set;
+    sun_rise_set(2024, 1 + iteration % 12, 1 + iteration % 28, -73.97, 40.78, &rise, &set);
+    _bench_sink = (uint32_t)(rise * 60);
+}
+
+static void _bench_spectrum(uint32_t iteration) {
+    // one FIFO block of a tone that drifts a little each run, on top of 1 g.
+    static const int16_t wave[8] = { 0, 707, 1000, 707, 0, -707, -1000, -707 };
+    int16_t samples[SPECTRUM_SIZE];
+    spectrum_peak_t peak = {0};
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        samples[i] = 16384 + wave[(i * (1 + iteration % 3)) % 8];
+    }
+    spectrum_find_peak(samples, 100000, &peak);
+    _bench_sink = peak.frequency_mhz;
+}
+
+static const bench_t _benchmarks[] = {
+    { "sha1", _bench_setup_data, _bench_sha1, NULL, 1, 0, false },
+    { "sha256", _bench_setup_data, _bench_sha256, NULL, 1, 0, false },
+    { "sha512", _bench_setup_data, _bench_sha512, NULL, 1, 0, false },
+    { "totp", _bench_setup_totp, _bench_totp, NULL, 1, 0, false },
+    { "display", NULL, _bench_display, _bench_display_teardown, 1, 0, false },
+    // writes and appends wear the flash and fill the filesystem, so they are capped.
+    { "fs_write", _bench_setup_data, _bench_fs_write, _bench_fs_teardown, 1, 32, false },
+    { "fs_read", _bench_setup_fs_read, _bench_fs_read, _bench_fs_teardown, 1, 0, false },
+    { "fs_append", _bench_setup_fs_append, _bench_fs_append, _bench_fs_teardown, 1, 64, false },
+    { "i2c_read8", _bench_setup_i2c, _bench_i2c, NULL, 1, 0, true },
+    { "unix_time", NULL, _bench_unix_time, NULL, 16, 0, false },
+    { "sunrise", NULL, _bench_sunrise, NULL, 1, 0, false },
+    { "spectrum", NULL, _bench_spectrum, NULL, 1, 0, false },
+};
+
+static void _bench_run(const bench_t *bench, uint32_t ticks, bool fast) {
+    if ((fast && bench->uses_cpu_clock) || (bench->setup && !bench->setup())) {
+        printf("%s,0,0,skipped\r\n", bench->name);
+        return;
+    }
+
+    // the counter keeps its own clock, so timing is unaffected by the CPU speed.
+    if (fast && !movement_begin_performance_burst()) {
+        printf("%s,0,0,battery low\r\n", bench->name);
+        movement_end_performance_burst();
+        if (bench->teardown) bench->teardown();
+        return;
+    }
+
+    // start on a tick boundary, so that the first partial tick isn't counted as a whole one.
+    rtc_counter_t start = watch_rtc_get_counter();
+    while (watch_rtc_get_counter() == start);
+    start = watch_rtc_get_counter();
+
+    uint32_t runs = 0;
+    rtc_counter_t elapsed;
+    do {
+        bench->run(runs++);
+        elapsed = watch_rtc_get_counter() - start;
+    } while (elapsed < ticks && (bench->max_runs == 0 || runs < bench->max_runs));
+
+    if (fast) movement_end_performance_burst();
+    if (bench->teardown) bench->teardown();
+
+    uint32_t ops = runs * bench->ops_per_run;
+    // hundredths of a microsecond per op
+    uint64_t per_op = (uint64_t)elapsed * 100000000ULL / ((uint64_t)watch_rtc_get_frequency() * ops);
+    printf("%s,%lu,%lu,%lu.%02lu\r\n", bench->name, (unsigned long)ops, (unsigned long)elapsed,
+           (unsigned long)(per_op / 100), (unsigned long)(per_op % 100));
+}
+
+int shell_bench_cmd(int argc, char *argv[]) {
+    const char *name = argc >= 2 ? argv[1] : "all";
+    uint32_t ticks = BENCH_DEFAULT_TICKS;
+    if (argc >= 3) {
+        ticks = strtoul(argv[2], NULL, 0);
+        if (ticks == 0) return -2;
+    }
+    bool fast = false;
+    if (argc >= 4) {
+        if (strcmp(argv[3], "fast")) return -2;
+        fast = true;
+    }
+
+    bool all = !strcmp(name, "all");
+    bool found = false;
+
+    printf("bench,ops,ticks,us_per_op\r\n");
+    for (size_t i = 0; i < sizeof(_benchmarks) / sizeof(_benchmarks[0]); i++) {
+        if (all || !strcmp(name, _benchmarks[i].name)) {
+            _bench_run(&_benchmarks[i], ticks, fast);
+            found = true;
+        }
+    }
+
+    if (!found) {
+        printf("no such benchmark; try one of:");
+        for (size_t i = 0; i < sizeof(_benchmarks) / sizeof(_benchmarks[0]); i++) {
+            printf(" %s", _benchmarks[i].name);
+        }
+        printf("\r\n");
+        return -1;
+    }
+
+    return 0;
+}
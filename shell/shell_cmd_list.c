@@ -27,14 +27,20 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "filesystem.h"
+#include "movement.h"
+#include "shell_bench.h"
 #include "watch.h"
+#include "watch_log.h"
 #include "delay.h"
 
 static int help_cmd(int argc, char *argv[]);
 static int flash_cmd(int argc, char *argv[]);
 static int stress_cmd(int argc, char *argv[]);
+static int log_cmd(int argc, char *argv[]);
+static int prof_cmd(int argc, char *argv[]);
 
 shell_command_t g_shell_commands[] = {
     {
@@ -107,6 +113,104 @@ shell_command_t g_shell_commands[] = {
         .max_args = 3,
         .cb = filesystem_cmd_echo,
     },
+    {
+        .name = "btn",
+        .help = "usage: btn {light,mode,alarm} {down,up,press}",
+        .min_args = 2,
+        .max_args = 2,
+        .cb = movement_cmd_btn,
+    },
+    {
+        .name = "inject",
+        .help = "usage: inject {tick,single_tap,double_tap,timeout,...|EVENT_NUMBER} [COUNT]",
+        .min_args = 1,
+        .max_args = 2,
+        .cb = movement_cmd_inject,
+    },
+    {
+        .name = "lcd",
+        .help = "print display segments, one line per common pin",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_lcd,
+    },
+    {
+        .name = "timing",
+        .help = "print RTC ticks spent on injected events; usage: timing [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = movement_cmd_timing,
+    },
+    {
+        .name = "burst",
+        .help = "print performance burst counts and estimated energy",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_burst,
+    },
+    {
+        .name = "beats",
+        .help = "print how far the beat engine has drifted from its tempo",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_beats,
+    },
+    {
+        .name = "light",
+        .help = "print the ambient light band and how many interrupts it took",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_light,
+    },
+    {
+        .name = "jobs",
+        .help = "print the job queue depth and how well slices kept to their budget",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_jobs,
+    },
+    {
+        .name = "stack",
+        .help = "print the deepest stack use, and with MOVEMENT_STACK_PROFILING, by face and event type",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_stack,
+    },
+    {
+        .name = "buttons",
+        .help = "print button interrupts against real edges; usage: buttons [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = movement_cmd_buttons,
+    },
+    {
+        .name = "boot",
+        .help = "print how long the last boot took to draw the first face and to finish",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_boot,
+    },
+    {
+        .name = "log",
+        .help = "dump the log ring for utils/watch_log; usage: log [clear]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = log_cmd,
+    },
+    {
+        .name = "prof",
+        .help = "sampling profiler for utils/watch_prof; usage: prof [on|off|clear|overhead]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = prof_cmd,
+    },
+    {
+        .name = "bench",
+        .help = "run microbenchmarks, print CSV; usage: bench [NAME|all] [TICKS] [fast]",
+        .min_args = 0,
+        .max_args = 3,
+        .cb = shell_bench_cmd,
+    },
     {
         .name = "stress",
         .help = "test CDC write; usage: stress [LEN] [DELAY_MS]",
@@ -141,6 +245,90 @@ static int flash_cmd(int argc, char *argv[]) {
     return 0;
 }
 
+static int log_cmd(int argc, char *argv[]) {
+    if (argc >= 2) {
+        if (strcmp(argv[1], "clear") != 0) return -1;
+        watch_log_clear();
+        return 0;
+    }
+
+    uint32_t words[2 + WATCH_LOG_MAX_ARGS];
+    uint32_t position = 0;
+    uint8_t size;
+
+    printf("# watch_log dropped=%lu freq=%lu\r\n", (unsigned long)watch_log_get_dropped(), (unsigned long)watch_rtc_get_frequency());
+    while ((size = watch_log_read(&position, words))) {
+#if __EMSCRIPTEN__
+        // there's no ELF to look the format strings up in, but they're right here in memory.
+        const char *fmt = (const char *)(uintptr_t)(words[0] & ~0x3);
+        printf("%lu.%03lu ", (unsigned long)(words[1] / watch_rtc_get_frequency()),
+            (unsigned long)((words[1] % watch_rtc_get_frequency()) * 1000 / watch_rtc_get_frequency()));
+        printf(fmt, words[2], words[3], words[4]);
+        printf("\r\n");
+#else
+        for (uint8_t i = 0; i < size; i++) printf(i ? " %08lx" : "%08lx", (unsigned long)words[i]);
+        printf("\r\n");
+#endif
+    }
+
+    return 0;
+}
+
+// Counts trips around an empty loop for a whole number of RTC ticks.
+static uint32_t _prof_spin(uint32_t ticks) {
+    volatile uint32_t iterations = 0;
+    rtc_counter_t start = watch_rtc_get_counter();
+    while (watch_rtc_get_counter() == start);
+    start = watch_rtc_get_counter();
+    while (watch_rtc_get_counter() - start < ticks) iterations++;
+    return iterations;
+}
+
+static int prof_cmd(int argc, char *argv[]) {
+    if (argc >= 2) {
+        if (!strcmp(argv[1], "on")) {
+            if (!watch_profiler_start()) {
+                printf("profiler unavailable\r\n");
+                return -1;
+            }
+        } else if (!strcmp(argv[1], "off")) {
+            watch_profiler_stop();
+        } else if (!strcmp(argv[1], "clear")) {
+            watch_profiler_free();
+        } else if (!strcmp(argv[1], "overhead")) {
+            // the same loop for a second with the profiler off and on: the difference is the share of the CPU
+            // that the sampling interrupt takes.
+            bool was_running = watch_profiler_is_running();
+            watch_profiler_stop();
+            uint32_t without = _prof_spin(128);
+            if (!watch_profiler_start()) {
+                printf("profiler unavailable\r\n");
+                return -1;
+            }
+            uint32_t with = _prof_spin(128);
+            if (!was_running) watch_profiler_stop();
+            printf("loops_off,loops_on,overhead_ppm\r\n");
+            printf("%lu,%lu,%lu\r\n", (unsigned long)without, (unsigned long)with,
+                (unsigned long)(with < without ? (uint64_t)(without - with) * 1000000 / without : 0));
+        } else {
+            return -1;
+        }
+        return 0;
+    }
+
+    uint16_t position = 0;
+    uint32_t pc;
+    uint16_t count;
+
+    printf("# watch_prof samples=%lu dropped=%lu period=%u running=%u\r\n", (unsigned long)watch_profiler_get_samples(),
+        (unsigned long)watch_profiler_get_dropped(), WATCH_PROFILER_PERIOD_CYCLES, watch_profiler_is_running());
+    while (watch_profiler_read(&position, &pc, &count)) {
+        printf("%08lx %u\r\n", (unsigned long)pc, count);
+    }
+
+    return 0;
+}
+
 #define STRESS_CMD_MAX_LEN  (512)
 static int stress_cmd(int argc, char *argv[]) {
     char test_str[STRESS_CMD_MAX_LEN+1] = {0};
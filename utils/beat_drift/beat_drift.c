@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Measures how far Movement's beat engine drifts over an hour, off the watch.
+ *
+ * It replays the deadline arithmetic of movement_start_beats and cb_beat against a simulated 128 Hz RTC
+ * in which every comp callback runs a random 0 to 3 ticks late, the way a busy interrupt or a slow face
+ * would delay it. At the end of the hour it counts the beats the way the shell's beats command does, and
+ * it also checks every deadline against the exact time of its beat. Keep it in step with movement.c if
+ * that arithmetic changes.
+ *
+ * Build:  cc -O2 -o beat_drift beat_drift.c
+ * Run:    ./beat_drift [seconds]      (one hour if not given)
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RTC_HZ 128
+#define MAX_LATE_TICKS 3
+
+static const uint32_t tempos[] = {
+    6000,   // 60 BPM, a whole number of ticks, as the breathing face plays it
+    7213,   // 72.13 BPM
+    1000,   // 10 BPM, six seconds a beat
+    12850,  // 128.5 BPM
+    33333,  // 333.33 BPM, a beat every 23 ticks or so
+};
+
+int main(int argc, char *argv[]) {
+    uint32_t seconds = argc > 1 ? strtoul(argv[1], NULL, 10) : 3600;
+    uint32_t end_tick = seconds * RTC_HZ;
+    int failed = 0;
+
+    srand(1);
+    printf("cbpm,elapsed_ticks,expected,played,drift,max_late_ticks,worst_deadline_error_ticks\n");
+    for (size_t t = 0; t < sizeof(tempos) / sizeof(tempos[0]); t++) {
+        uint32_t cbpm = tempos[t];
+
+        // movement_start_beats
+        uint32_t ticks_per_minute_x100 = 6000 * RTC_HZ;
+        uint32_t period_ticks = ticks_per_minute_x100 / cbpm;
+        uint32_t period_remainder = ticks_per_minute_x100 % cbpm;
+        uint32_t error = 0;
+        uint32_t start_counter = 1;
+        uint32_t beat_counter = start_counter;
+
+        uint32_t played = 0;
+        uint32_t max_late_ticks = 0;
+        int64_t worst_deadline_error = 0;
+        uint32_t now = 0;
+
+        while (beat_counter <= end_tick) {
+            // the comp interrupt fires on the deadline, or as soon as the RTC gets to it if it has already passed.
+            uint32_t late = rand() % (MAX_LATE_TICKS + 1);
+            now = (beat_counter > now ? beat_counter : now) + late;
+            if (now - beat_counter > max_late_ticks) max_late_ticks = now - beat_counter;
+
+            // beat n is due exactly n * 6000 * RTC_HZ / cbpm ticks after the first.
+            int64_t exact_x_cbpm = (int64_t)played * ticks_per_minute_x100;
+            int64_t deadline_error = (int64_t)(beat_counter - start_counter) * cbpm - exact_x_cbpm;
+            if (llabs(deadline_error) > llabs(worst_deadline_error)) worst_deadline_error = deadline_error;
+            played++;
+
+            // cb_beat
+            uint32_t counter = beat_counter + period_ticks;
+            error += period_remainder;
+            if (error >= cbpm) {
+                error -= cbpm;
+                counter++;
+            }
+            beat_counter = counter;
+        }
+
+        // movement_cmd_beats
+        uint32_t elapsed_ticks = end_tick - start_counter;
+        uint64_t expected = ((uint64_t)(elapsed_ticks + 1) * cbpm + ticks_per_minute_x100 - 1) / ticks_per_minute_x100;
+        long drift = (long)played - (long)expected;
+        // a deadline may only ever round down, by less than a tick.
+        if (drift != 0 || worst_deadline_error > 0 || -worst_deadline_error >= cbpm) failed = 1;
+
+        printf("%lu,%lu,%lu,%lu,%ld,%lu,%.4f\n", (unsigned long)cbpm, (unsigned long)elapsed_ticks,
+               (unsigned long)expected, (unsigned long)played, drift, (unsigned long)max_late_ticks,
+               (double)worst_deadline_error / cbpm);
+    }
+
+    return failed;
+}
@@ -0,0 +1,351 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Decodes a raw SPI flash capture written by accelerometer_data_acquisition_face,
+ * without going through a text dump first.
+ *
+ * Build:  make            (or cc -O2 -o motion_decode motion_decode.c)
+ * Test:   make test       (checks it against process_motion_dump.py on sample.bin)
+ *
+ * Usage:  motion_decode [-t | -o DIR] [CAPTURE]
+ *
+ *   (default)  one CSV table on stdout, one row per sample, for every event:
+ *              event,activity,timestamp,range,t,x,y,z
+ *   -o DIR     one CSV per event plus DIR/makeplots.sh, named and laid out the
+ *              same way as process_motion_dump.py's output.
+ *   -t         a text dump in the format process_motion_dump.py reads, so both
+ *              tools can be checked against each other:
+ *              ./motion_decode -t capture.bin | ./process_motion_dump.py
+ *
+ * CAPTURE defaults to stdin. t is seconds since the event started; x, y and z
+ * are in m/s².
+ *
+ * Flash layout: 256-byte pages. The first four pages are a bitmap of used pages;
+ * every other page holds 32 little-endian 64-bit records. A header record
+ * (type 2) starts an event and is followed by its data records (type 1);
+ * erased (type 3) and deleted (type 0) records are skipped.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PAGE_SIZE 256
+#define BITMAP_PAGES 4
+#define RECORD_SIZE 8
+#define MAX_PATH_LENGTH 4096
+
+#define RECORD_TYPE_DELETED 0
+#define RECORD_TYPE_DATA 1
+#define RECORD_TYPE_HEADER 2
+#define RECORD_TYPE_INVALID 3
+
+typedef enum {
+    OUTPUT_TABLE,
+    OUTPUT_EVENT_FILES,
+    OUTPUT_TEXT_DUMP,
+} output_mode_t;
+
+typedef struct {
+    const char code[3];
+    const char *name;
+} activity_t;
+
+// same codes and names as accelerometer_data_acquisition_face and process_motion_dump.py
+static const activity_t activities[] = {
+    { "TE", "testing" },
+    { "ID", "idle" },
+    { "OF", "off_wrist" },
+    { "SL", "sleeping" },
+    { "WH", "washing_hands" },
+    { "WA", "walking" },
+    { "WB", "walking_with_beverage" },
+    { "JO", "jogging" },
+    { "RU", "running" },
+    { "BI", "biking" },
+    { "HI", "hiking" },
+    { "EL", "elliptical" },
+    { "SU", "stairs_up" },
+    { "SD", "stairs_down" },
+    { "WL", "weight_lifting" },
+};
+
+// micro-g per LSB of the 14-bit samples, indexed by lis2dw_range_t
+static const uint32_t range_ug_per_lsb[4] = { 244, 488, 976, 1952 };
+static const uint8_t range_g[4] = { 2, 4, 8, 16 };
+
+typedef struct {
+    output_mode_t mode;
+    const char *directory;
+    FILE *out;          // the table or text dump; the event's CSV file in OUTPUT_EVENT_FILES
+    FILE *script;       // makeplots.sh in OUTPUT_EVENT_FILES
+    bool in_event;
+    uint32_t num_events;
+    uint32_t num_records;
+    // the current event
+    char code[3];
+    char name[64];
+    uint32_t timestamp;
+    uint8_t range;
+} decoder_t;
+
+// Appends value / 1000 with three decimals. Much faster than printf's %f, which dominates the run time otherwise.
+static char *format_milli(char *p, int32_t value) {
+    if (value < 0) {
+        *p++ = '-';
+        value = -value;
+    }
+    char digits[12];
+    int n = 0;
+    uint32_t v = (uint32_t)value;
+    do {
+        digits[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v || n < 4);
+    while (n > 3) *p++ = digits[--n];
+    *p++ = '.';
+    while (n > 0) *p++ = digits[--n];
+    return p;
+}
+
+static char *format_unsigned(char *p, uint32_t value) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    while (n > 0) *p++ = digits[--n];
+    return p;
+}
+
+static int32_t milli_meters_per_second_squared(uint16_t accel, uint8_t range) {
+    int64_t raw = (int64_t)accel - 8192;
+    int64_t scaled = raw * range_ug_per_lsb[range] * 980665;
+    // micro-g times standard gravity in 1e-5 m/s², to 1e-3 m/s², rounded half away from zero
+    return (int32_t)((scaled + (scaled < 0 ? -50000000 : 50000000)) / 100000000);
+}
+
+static const char *activity_name(const char *code) {
+    for (size_t i = 0; i < sizeof(activities) / sizeof(activities[0]); i++) {
+        if (!memcmp(activities[i].code, code, 2)) return activities[i].name;
+    }
+    return NULL;
+}
+
+static void end_event(decoder_t *decoder) {
+    if (!decoder->in_event) return;
+    decoder->in_event = false;
+    if (decoder->mode == OUTPUT_EVENT_FILES) {
+        fclose(decoder->out);
+        decoder->out = NULL;
+    } else if (decoder->mode == OUTPUT_TEXT_DUMP) {
+        fputs("=== END ===\n", decoder->out);
+    }
+}
+
+static bool begin_event(decoder_t *decoder, uint64_t record) {
+    end_event(decoder);
+
+    decoder->range = (record >> 2) & 0x3;
+    decoder->code[0] = (record >> 16) & 0xFF;
+    decoder->code[1] = (record >> 24) & 0xFF;
+    decoder->code[2] = 0;
+    decoder->timestamp = (uint32_t)(record >> 32);
+    decoder->in_event = true;
+    decoder->num_events++;
+
+    // named the way process_motion_dump.py names them: long activity name, lower case, dashes for underscores.
+    const char *name = activity_name(decoder->code);
+    snprintf(decoder->name, sizeof(decoder->name), "%s.%u", name ? name : decoder->code, decoder->timestamp);
+    for (char *c = decoder->name; *c; c++) {
+        if (*c == '_') *c = '-';
+        else if (*c >= 'A' && *c <= 'Z') *c += 'a' - 'A';
+    }
+
+    switch (decoder->mode) {
+        case OUTPUT_TABLE:
+            break;
+        case OUTPUT_TEXT_DUMP:
+            fprintf(decoder->out, "%s.%u.CSV\nt,x,y,z\n", decoder->code, decoder->timestamp);
+            break;
+        case OUTPUT_EVENT_FILES: {
+            char path[MAX_PATH_LENGTH];
+            snprintf(path, sizeof(path), "%s/%s.csv", decoder->directory, decoder->name);
+            decoder->out = fopen(path, "w");
+            if (decoder->out == NULL) {
+                fprintf(stderr, "motion_decode: %s: %s\n", path, strerror(errno));
+                return false;
+            }
+            fputs("t,x,y,z\n", decoder->out);
+            fprintf(decoder->script, "../csv2gnuplot.sh -i \"%s.csv\" -O \"./plots/%s.png\"  -g \"%s.gnuplot\" -F png -W 1200 -H 675 -e -l -G ../plot.options && rm \"%s.gnuplot\"\n",
+                    decoder->name, decoder->name, decoder->name, decoder->name);
+            break;
+        }
+    }
+
+    return true;
+}
+
+static void decode_sample(decoder_t *decoder, uint64_t record) {
+    char line[128];
+    char *p = line;
+
+    uint16_t x = (record >> 2) & 0x3FFF;
+    uint16_t y = (record >> 18) & 0x3FFF;
+    uint16_t z = (record >> 34) & 0x3FFF;
+    uint16_t counter = (uint16_t)(record >> 48);
+
+    if (decoder->mode == OUTPUT_TABLE) {
+        p = format_unsigned(p, decoder->num_events);
+        *p++ = ',';
+        const char *name = activity_name(decoder->code);
+        size_t len = strlen(name ? name : decoder->code);
+        memcpy(p, name ? name : decoder->code, len);
+        p += len;
+        *p++ = ',';
+        p = format_unsigned(p, decoder->timestamp);
+        *p++ = ',';
+        p = format_unsigned(p, range_g[decoder->range]);
+        *p++ = ',';
+    }
+
+    p = format_unsigned(p, counter / 100);
+    *p++ = '.';
+    *p++ = '0' + (counter % 100) / 10;
+    *p++ = '0' + counter % 10;
+    *p++ = ',';
+    p = format_milli(p, milli_meters_per_second_squared(x, decoder->range));
+    *p++ = ',';
+    p = format_milli(p, milli_meters_per_second_squared(y, decoder->range));
+    *p++ = ',';
+    p = format_milli(p, milli_meters_per_second_squared(z, decoder->range));
+    *p++ = '\n';
+
+    fwrite(line, 1, p - line, decoder->out);
+    decoder->num_records++;
+}
+
+static bool decode_page(decoder_t *decoder, const uint8_t *page) {
+    for (size_t offset = 0; offset < PAGE_SIZE; offset += RECORD_SIZE) {
+        uint64_t record = 0;
+        for (int i = RECORD_SIZE - 1; i >= 0; i--) {
+            record = (record << 8) | page[offset + i];
+        }
+
+        switch (record & 0x3) {
+            case RECORD_TYPE_HEADER:
+                if (!begin_event(decoder, record)) return false;
+                break;
+            case RECORD_TYPE_DATA:
+                // samples before the first header have no event to belong to.
+                if (decoder->in_event) decode_sample(decoder, record);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: motion_decode [-t | -o DIR] [CAPTURE]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    decoder_t decoder = { .mode = OUTPUT_TABLE, .out = stdout };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "to:")) != -1) {
+        switch (opt) {
+            case 't':
+                decoder.mode = OUTPUT_TEXT_DUMP;
+                break;
+            case 'o':
+                decoder.mode = OUTPUT_EVENT_FILES;
+                decoder.directory = optarg;
+                break;
+            default:
+                usage();
+        }
+    }
+    if (argc - optind > 1) usage();
+
+    FILE *in = stdin;
+    if (optind < argc) {
+        in = fopen(argv[optind], "rb");
+        if (in == NULL) {
+            fprintf(stderr, "motion_decode: %s: %s\n", argv[optind], strerror(errno));
+            return 1;
+        }
+    }
+
+    static char out_buf[1 << 16];
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+
+    if (decoder.mode == OUTPUT_EVENT_FILES) {
+        char path[MAX_PATH_LENGTH];
+        snprintf(path, sizeof(path), "%s/plots", decoder.directory);
+        mkdir(decoder.directory, 0777);
+        mkdir(path, 0777);
+        snprintf(path, sizeof(path), "%s/makeplots.sh", decoder.directory);
+        decoder.script = fopen(path, "w");
+        if (decoder.script == NULL) {
+            fprintf(stderr, "motion_decode: %s: %s\n", path, strerror(errno));
+            return 1;
+        }
+    } else if (decoder.mode == OUTPUT_TABLE) {
+        fputs("event,activity,timestamp,range,t,x,y,z\n", stdout);
+    }
+
+    uint8_t page[PAGE_SIZE];
+    uint32_t page_number = 0;
+    bool ok = true;
+    while (ok && fread(page, 1, PAGE_SIZE, in) == PAGE_SIZE) {
+        if (page_number++ >= BITMAP_PAGES) ok = decode_page(&decoder, page);
+    }
+    if (ferror(in)) {
+        fprintf(stderr, "motion_decode: read error\n");
+        ok = false;
+    }
+    end_event(&decoder);
+
+    if (decoder.script) fclose(decoder.script);
+    fflush(stdout);
+
+    fprintf(stderr, "Processed %u records in %u events!\n", decoder.num_records, decoder.num_events);
+    if (decoder.mode == OUTPUT_EVENT_FILES) {
+        fprintf(stderr, "To generate plots: cd %s && bash makeplots.sh\n", decoder.directory);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+#!/bin/bash
+# Regression test for motion_decode: sample.bin is a small flash capture and sample.txt the text dump it holds.
+# process_motion_dump.py splits the dump into one CSV per event, and motion_decode -o has to produce the same files
+# straight from the capture. motion_decode -t has to reproduce the dump itself.
+set -e
+
+here="$(cd "$(dirname "$0")" && pwd)"
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+
+# the Python tool writes to ./output, and reads stdin unless it's a terminal.
+(cd "$work" && python3 "$here/process_motion_dump.py" < "$here/sample.txt" > /dev/null)
+"$here/motion_decode" -o "$work/decoded" "$here/sample.bin" 2> /dev/null
+diff -r "$work/output" "$work/decoded"
+
+"$here/motion_decode" -t "$here/sample.bin" 2> /dev/null | diff "$here/sample.txt" -
+
+echo "motion_decode matches process_motion_dump.py"
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Renders the records of the watch_log ring from the firmware's ELF file.
+
+Usage: watch_log_decode.py firmware.elf [dump.txt]
+
+The dump is the output of the shell's log command, read from stdin if no file
+is given. Each record line holds hex words: the address of the format string
+(with the argument count in its low two bits), the RTC counter, then up to
+three arguments. The format strings are read from the ELF, so nothing but the
+raw words has to leave the watch.
+"""
+import re
+import struct
+import sys
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diouxXcp%])')
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError(f'{path} is not a little-endian 32-bit ELF file')
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from('<IIIIII', self.data, shoff + i * shentsize)
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, offset, size))
+
+    def string_at(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.index(b'\0', start, offset + size)
+                return self.data[start:end].decode('utf-8', 'replace')
+        return None
+
+
+def render(fmt, args):
+    args = iter(args)
+
+    def convert(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        value = next(args, 0)
+        if conversion in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conversion = 'd'
+        elif conversion == 'u':
+            conversion = 'd'
+        elif conversion == 'p':
+            return f'0x{value:08x}'
+        elif conversion == 'c':
+            value = value & 0xFF
+        spec = '%' + flags + width + ('.' + precision if precision else '') + conversion
+        return spec % value
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+
+    elf = Elf(sys.argv[1])
+    input_stream = open(sys.argv[2], 'r') if len(sys.argv) > 2 else sys.stdin
+    freq = 128
+
+    for line in input_stream:
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith('#'):
+            fields = dict(field.split('=', 1) for field in line.split()[2:] if '=' in field)
+            freq = int(fields.get('freq', freq))
+            if int(fields.get('dropped', 0)):
+                print(f'({fields["dropped"]} older records dropped)')
+            continue
+        try:
+            words = [int(word, 16) for word in line.split()]
+        except ValueError:
+            continue  # the shell's prompt or echo
+        if len(words) < 2:
+            continue
+
+        fmt = elf.string_at(words[0] & ~0x3)
+        if fmt is None:
+            fmt = f'<unknown format at 0x{words[0] & ~0x3:08x}>' + ' %x' * (words[0] & 0x3)
+        seconds, ticks = divmod(words[1], freq)
+        print(f'{seconds}.{ticks * 1000 // freq:03d} {render(fmt, words[2:])}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Prints a flat profile from the watch's sampling profiler.
+
+Usage: watch_prof_report.py firmware.elf [dump.txt]
+
+The dump is the output of the shell's prof command, read from stdin if no file
+is given. Each line holds a sampled program counter and its count, in hex and
+decimal. The addresses are mapped onto functions with the ELF's symbol table,
+so the ELF must be the one the watch is running.
+"""
+import bisect
+import struct
+import sys
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError(f'{path} is not a little-endian 32-bit ELF file')
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2E)
+        self.sections = [struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize) for i in range(shnum)]
+
+    def functions(self):
+        """Returns (address, size, name) for each function, sorted by address."""
+        functions = {}
+        for _, sh_type, _, _, offset, size, link, _, _, entsize in self.sections:
+            if sh_type != SHT_SYMTAB:
+                continue
+            strtab_offset = self.sections[link][4]
+            for i in range(size // entsize):
+                st_name, st_value, st_size, st_info = struct.unpack_from('<IIIB', self.data, offset + i * entsize)
+                if st_info & 0xF != STT_FUNC or st_value == 0:
+                    continue
+                end = self.data.index(b'\0', strtab_offset + st_name)
+                name = self.data[strtab_offset + st_name:end].decode('utf-8', 'replace')
+                # Thumb functions have the low bit set in their symbol value.
+                functions.setdefault(st_value & ~1, (st_size, name))
+        return sorted((address, size, name) for address, (size, name) in functions.items())
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+
+    functions = Elf(sys.argv[1]).functions()
+    starts = [address for address, _, _ in functions]
+    input_stream = open(sys.argv[2], 'r') if len(sys.argv) > 2 else sys.stdin
+
+    counts = {}
+    total = 0
+    header = ''
+    for line in input_stream:
+        line = line.strip()
+        if line.startswith('#'):
+            header = line
+            continue
+        fields = line.split()
+        if len(fields) != 2:
+            continue  # the shell's prompt or echo
+        try:
+            pc, count = int(fields[0], 16), int(fields[1])
+        except ValueError:
+            continue
+
+        i = bisect.bisect_right(starts, pc) - 1
+        if i >= 0 and pc < functions[i][0] + max(functions[i][1], 2):
+            name = functions[i][2]
+        else:
+            name = f'?? 0x{pc:08x}'
+        counts[name] = counts.get(name, 0) + count
+        total += count
+
+    if header:
+        fields = dict(field.split('=', 1) for field in header.split()[2:] if '=' in field)
+        dropped = int(fields.get('dropped', 0))
+        if dropped:
+            print(f'({dropped} samples dropped: the table had no slot for them)')
+    if not total:
+        sys.exit('no samples')
+
+    print(f'{"%":>6} {"samples":>8}  function')
+    for name, count in sorted(counts.items(), key=lambda item: -item[1]):
+        print(f'{count * 100 / total:6.2f} {count:8d}  {name}')
+
+
+if __name__ == '__main__':
+    main()
@@ -27,57 +27,46 @@
 #include "beats_face.h"
 #include "watch.h"
 
-const uint8_t BEAT_REFRESH_FREQUENCY = 8;
+// Centibeats at a moment, for movement_redraw_on_change. BMT is UTC+1, and the day has 100000 centibeats.
+static uint32_t _beats_face_value_at(uint32_t timestamp, uint32_t ticks, void *context) {
+    (void) context;
+    uint32_t seconds = (timestamp + 3600) % 86400;
+    return clock2beats(seconds / 3600, (seconds / 60) % 60, seconds % 60, ticks);
+}
+
+static void _beats_face_display(uint32_t centibeats) {
+    char buf[16];
+    sprintf(buf, "%6u", (unsigned int)centibeats); // Cast to unsigned int to avoid compiler warnings, as centibeats is 0-100000
+
+    watch_display_text_with_fallback(WATCH_POSITION_TOP, "beat", "bt");
+    watch_display_text(WATCH_POSITION_BOTTOM, buf);
+}
 
 void beats_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     (void) context_ptr;
-    if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(beats_face_state_t));
-    }
 }
 
 void beats_face_activate(void *context) {
-    beats_face_state_t *state = (beats_face_state_t *)context;
-    state->next_subsecond_update = 0;
-    state->last_centibeat_displayed = 0;
-    movement_request_tick_frequency(BEAT_REFRESH_FREQUENCY);
+    (void) context;
+    // Movement wakes us for each new centibeat, so there's nothing to tick for.
+    movement_request_tick_frequency(0);
+    movement_redraw_on_change(_beats_face_value_at, NULL);
 }
 
 bool beats_face_loop(movement_event_t event, void *context) {
-    beats_face_state_t *state = (beats_face_state_t *)context;
-    if (event.event_type == EVENT_TICK && event.subsecond != state->next_subsecond_update) {
-         return true; // math is hard, don't do it if we don't have to.
-    }
-
+    (void) context;
     char buf[16];
     uint32_t centibeats;
 
-    watch_date_time_t date_time;
-    uint8_t bmt_hour; // BMT = Biel Mean Time
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-        case EVENT_TICK:
-            date_time = movement_get_utc_date_time();
-            bmt_hour = (date_time.unit.hour + 1) % 24;
-            centibeats = clock2beats(bmt_hour, date_time.unit.minute, date_time.unit.second, event.subsecond);
-            if (centibeats == state->last_centibeat_displayed) {
-                // we missed this update, try again next subsecond
-                state->next_subsecond_update = (event.subsecond + 1) % BEAT_REFRESH_FREQUENCY;
-            } else {
-                state->next_subsecond_update = (event.subsecond + 1 + (BEAT_REFRESH_FREQUENCY * 2 / 3)) % BEAT_REFRESH_FREQUENCY;
-                state->last_centibeat_displayed = centibeats;
-            }
-            sprintf(buf, "%6u", (unsigned int)centibeats); // Cast to unsigned int to avoid compiler warnings, as centibeats is 0-100000
-
-            watch_display_text_with_fallback(WATCH_POSITION_TOP, "beat", "bt");
-            watch_display_text(WATCH_POSITION_BOTTOM, buf);
+        case EVENT_VALUE_CHANGED:
+            _beats_face_display(movement_redraw_get_value());
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             if (!watch_sleep_animation_is_running()) watch_start_sleep_animation(432);
-            date_time = movement_get_utc_date_time();
-            bmt_hour = (date_time.unit.hour + 1) % 24;
-            centibeats = clock2beats(bmt_hour, date_time.unit.minute, date_time.unit.second, event.subsecond);
+            centibeats = _beats_face_value_at(movement_get_utc_timestamp(), 0, NULL);
             sprintf(buf, "%4u  ", (unsigned int)(centibeats / 100));
 
             watch_display_text_with_fallback(WATCH_POSITION_TOP, "beat", "bt");
@@ -95,9 +84,9 @@ void beats_face_resign(void *context) {
     (void) context;
 }
 
-uint32_t clock2beats(uint32_t hours, uint32_t minutes, uint32_t seconds, uint32_t subseconds) {
+uint32_t clock2beats(uint32_t hours, uint32_t minutes, uint32_t seconds, uint32_t ticks) {
     // Calculate total milliseconds since midnight
-    uint32_t ms = ((hours * 3600 + minutes * 60 + seconds) * 1000) + ((subseconds * 1000) / BEAT_REFRESH_FREQUENCY);
+    uint32_t ms = ((hours * 3600 + minutes * 60 + seconds) * 1000) + ((ticks * 1000) / watch_rtc_get_frequency());
     // 1 beat = 86.4 seconds = 86400 ms, so 1 centibeat = 864 ms
     uint32_t centibeats = ms / 864;
     centibeats %= 100000;
@@ -45,12 +45,8 @@
 
 #include "movement.h"
 
-typedef struct {
-    int8_t next_subsecond_update;
-    uint32_t last_centibeat_displayed;
-} beats_face_state_t;
-
-uint32_t clock2beats(uint32_t hours, uint32_t minutes, uint32_t seconds, uint32_t subseconds);
+// ticks are 1/watch_rtc_get_frequency() of a second.
+uint32_t clock2beats(uint32_t hours, uint32_t minutes, uint32_t seconds, uint32_t ticks);
 void beats_face_setup(uint8_t watch_face_index, void ** context_ptr);
 void beats_face_activate(void *context);
 bool beats_face_loop(movement_event_t event, void *context);
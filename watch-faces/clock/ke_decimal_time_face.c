@@ -35,14 +35,16 @@ static void _display_date(watch_date_time_t date_time) {
     watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
 }
 
-static void _display_time(ke_decimal_time_state_t *state, watch_date_time_t date_time, bool low_energy) {
-    char buf[8];
-    uint32_t value = date_time.unit.hour * 3600 + date_time.unit.minute * 60 + date_time.unit.second;
+// Hundredths of a percent of the local day, for movement_redraw_on_change.
+static uint32_t _decimal_time_at(uint32_t timestamp, uint32_t ticks, void *context) {
+    ke_decimal_time_state_t *state = (ke_decimal_time_state_t *)context;
+    (void) ticks;
+    return ((timestamp + state->timezone_offset) % 86400) * 100 / 864;
+}
 
-    if (value == state->previous_time) return;
+static void _display_time(uint32_t value, bool low_energy) {
+    char buf[8];
 
-    value = value * 100;
-    value = value / 864;
     snprintf(buf, sizeof(buf), "%04ld#o", value);
 
     // if under 10%, display 0.00 instead of 00.00
@@ -52,8 +54,6 @@ static void _display_time(ke_decimal_time_state_t *state, watch_date_time_t date
     if (low_energy) buf[3] = 0;
 
     watch_display_text(WATCH_POSITION_BOTTOM, buf);
-
-    state->previous_time = value;
 }
 
 void ke_decimal_time_face_setup(uint8_t watch_face_index, void ** context_ptr) {
@@ -73,14 +73,18 @@ void ke_decimal_time_face_activate(void *context) {
         watch_stop_sleep_animation();
     }
 
-    // force re-display of date and time in EVENT_ACTIVATE
+    // force re-display of the date in EVENT_ACTIVATE
     state->previous_day = 0xFF;
-    state->previous_time = 0xFFFFFFFF;
+    state->timezone_offset = movement_get_current_timezone_offset();
+    // Movement wakes us with EVENT_VALUE_CHANGED each time the displayed value moves on, every 8.64 seconds;
+    // nothing needs a tick in between.
+    movement_request_tick_frequency(0);
+    movement_redraw_on_change(_decimal_time_at, state);
 }
 
 bool ke_decimal_time_face_loop(movement_event_t event, void *context) {
     ke_decimal_time_state_t *state = (ke_decimal_time_state_t *)context;
-    watch_date_time_t date_time = movement_get_local_date_time();
+    watch_date_time_t date_time;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
@@ -89,12 +93,15 @@ bool ke_decimal_time_face_loop(movement_event_t event, void *context) {
                 watch_set_indicator(WATCH_INDICATOR_SIGNAL);
             }
             // fall through
-        case EVENT_TICK:
-            _display_time(state, date_time, false);
+        case EVENT_VALUE_CHANGED:
+            _display_time(movement_redraw_get_value(), false);
+            date_time = movement_get_local_date_time();
             if (state->previous_day != date_time.unit.day) {
                 _display_date(date_time);
                 state->previous_day = date_time.unit.day;
             }
+            // pick up a DST change from the next value on
+            state->timezone_offset = movement_get_current_timezone_offset();
             break;
         case EVENT_LIGHT_BUTTON_UP:
             // You can use the Light button for your own purposes. Note that by default, Movement will also
@@ -118,7 +125,8 @@ bool ke_decimal_time_face_loop(movement_event_t event, void *context) {
                 watch_display_text(WATCH_POSITION_SECONDS, "  ");
                 watch_display_text(WATCH_POSITION_MINUTES, "  ");
             }
-            _display_time(state, date_time, true);
+            state->timezone_offset = movement_get_current_timezone_offset();
+            _display_time(_decimal_time_at(movement_get_utc_timestamp(), 0, state), true);
             break;
         default:
             // Movement's default loop handler will step in for any cases you don't handle above:
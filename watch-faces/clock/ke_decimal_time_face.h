@@ -40,7 +40,7 @@
 
 typedef struct {
     uint8_t previous_day;
-    uint32_t previous_time;
+    int32_t timezone_offset;
 } ke_decimal_time_state_t;
 
 void ke_decimal_time_face_setup(uint8_t watch_face_index, void ** context_ptr);
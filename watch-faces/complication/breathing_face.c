@@ -30,20 +30,43 @@
 typedef struct {
     uint8_t current_stage;
     uint8_t indication_mode; // 0 = sound only, 1 = LED only, 2 = all off
-    uint8_t led_on_state; // 0 = LED off, 1 = LED on
 } breathing_state_t;
 
 static void update_indicators(breathing_state_t *state);
 
-const int NOTE_LENGTH = 80;
-static const watch_buzzer_note_t IN_NOTES[] = { BUZZER_NOTE_C4, BUZZER_NOTE_D4, BUZZER_NOTE_E4 };
-static const uint16_t IN_DUR[] = { NOTE_LENGTH, NOTE_LENGTH, NOTE_LENGTH };
-static const watch_buzzer_note_t IN_HOLD_NOTES[] = { BUZZER_NOTE_E4, BUZZER_NOTE_REST, BUZZER_NOTE_E4 };
-static const uint16_t IN_HOLD_DUR[] = { NOTE_LENGTH, NOTE_LENGTH * 2, NOTE_LENGTH };
-static const watch_buzzer_note_t OUT_NOTES[] = { BUZZER_NOTE_E4, BUZZER_NOTE_D4, BUZZER_NOTE_C4 };
-static const uint16_t OUT_DUR[] = { NOTE_LENGTH, NOTE_LENGTH, NOTE_LENGTH };
-static const watch_buzzer_note_t OUT_HOLD_NOTES[] = { BUZZER_NOTE_C4, BUZZER_NOTE_REST * 2, BUZZER_NOTE_C4 };
-static const uint16_t OUT_HOLD_DUR[] = { NOTE_LENGTH, NOTE_LENGTH, NOTE_LENGTH };
+// Each phase lasts four beats at one beat per second. The cues are played by Movement's beat engine, right on
+// the beat, and the face only redraws the countdown when it gets EVENT_BEAT.
+#define BREATHING_CENTIBEATS_PER_MINUTE 6000
+#define BREATHING_BEATS_PER_PHASE 4
+#define NOTE_LENGTH 5 // 1/64 s, about 80 ms
+
+static int8_t IN_NOTES[] = { BUZZER_NOTE_C4, NOTE_LENGTH, BUZZER_NOTE_D4, NOTE_LENGTH, BUZZER_NOTE_E4, NOTE_LENGTH, 0 };
+static int8_t IN_HOLD_NOTES[] = { BUZZER_NOTE_E4, NOTE_LENGTH, BUZZER_NOTE_REST, NOTE_LENGTH * 2, BUZZER_NOTE_E4, NOTE_LENGTH, 0 };
+static int8_t OUT_NOTES[] = { BUZZER_NOTE_E4, NOTE_LENGTH, BUZZER_NOTE_D4, NOTE_LENGTH, BUZZER_NOTE_C4, NOTE_LENGTH, 0 };
+static int8_t OUT_HOLD_NOTES[] = { BUZZER_NOTE_C4, NOTE_LENGTH, BUZZER_NOTE_REST, NOTE_LENGTH, BUZZER_NOTE_C4, NOTE_LENGTH, 0 };
+
+static const movement_beat_step_t SOUND_STEPS[] = {
+    { BREATHING_BEATS_PER_PHASE, IN_NOTES, 0, 0, 0, 0 },
+    { BREATHING_BEATS_PER_PHASE, IN_HOLD_NOTES, 0, 0, 0, 0 },
+    { BREATHING_BEATS_PER_PHASE, OUT_NOTES, 0, 0, 0, 0 },
+    { BREATHING_BEATS_PER_PHASE, OUT_HOLD_NOTES, 0, 0, 0, 0 },
+};
+// green to breathe, red to hold; lit for most of the first beat of each phase.
+static const movement_beat_step_t LED_STEPS[] = {
+    { BREATHING_BEATS_PER_PHASE, NULL, 0, 0xFF, 0, 100 },
+    { BREATHING_BEATS_PER_PHASE, NULL, 0xFF, 0, 0, 100 },
+    { BREATHING_BEATS_PER_PHASE, NULL, 0, 0xFF, 0, 100 },
+    { BREATHING_BEATS_PER_PHASE, NULL, 0xFF, 0, 0, 100 },
+};
+static const movement_beat_step_t SILENT_STEPS[] = {
+    { BREATHING_BEATS_PER_PHASE * 4, NULL, 0, 0, 0, 0 },
+};
+
+static const movement_beat_pattern_t PATTERNS[] = {
+    { BREATHING_CENTIBEATS_PER_MINUTE, SOUND_STEPS, 4 },
+    { BREATHING_CENTIBEATS_PER_MINUTE, LED_STEPS, 4 },
+    { BREATHING_CENTIBEATS_PER_MINUTE, SILENT_STEPS, 1 },
+};
 
 void breathing_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index; // Unused parameter
@@ -51,7 +74,6 @@ void breathing_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         breathing_state_t *state = malloc(sizeof(breathing_state_t));
         state->current_stage = 0;
         state->indication_mode = 0; // Start with sound only
-        state->led_on_state = 0;
         *context_ptr = state;
     }
 }
@@ -60,6 +82,7 @@ void breathing_face_activate(void *context) {
     breathing_state_t *state = (breathing_state_t *)context;
     state->current_stage = 0;
     update_indicators(state);
+    movement_start_beats(&PATTERNS[state->indication_mode]);
 }
 
 static void update_indicators(breathing_state_t *state) {
@@ -80,16 +103,61 @@ static void update_indicators(breathing_state_t *state) {
     }
 }
 
-static void breathe_notify(breathing_state_t *state, const watch_buzzer_note_t *notes, const uint16_t *durations, size_t count, bool use_red_led) {
-    if (state->indication_mode == 2) return;
-    for (size_t i = 0; i < count; i++) {
-        if (state->indication_mode == 1 && notes[i] != BUZZER_NOTE_REST) {
-            if (use_red_led) watch_set_led_red();
-            else watch_set_led_green();
-            state->led_on_state = 1;
-        } else if (state->indication_mode == 0) {
-            watch_buzzer_play_note(notes[i], durations[i]);
-        }
+static void display_stage(uint8_t stage) {
+    switch (stage) {
+        case 0:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Breath", "Breath");
+            break;
+        case 1:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   3", "In   3");
+            break;
+        case 2:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   2", "In   2");
+            break;
+        case 3:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   1", "In   1");
+            break;
+
+        case 4:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 4", "Hold 4");
+            break;
+        case 5:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 3", "Hold 3");
+            break;
+        case 6:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 2", "Hold 2");
+            break;
+        case 7:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 1", "Hold 1");
+            break;
+
+        case 8:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  4", "Ou t 4");
+            break;
+        case 9:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  3", "Ou t 3");
+            break;
+        case 10:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  2", "Ou t 2");
+            break;
+        case 11:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  1", "Ou t 1");
+            break;
+
+        case 12:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 4", "Hold 4");
+            break;
+        case 13:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 3", "Hold 3");
+            break;
+        case 14:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 2", "Hold 2");
+            break;
+        case 15:
+            watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 1", "Hold 1");
+            break;
+        default:
+            break;
     }
 }
 
@@ -98,91 +166,22 @@ bool breathing_face_loop(movement_event_t event, void *context) {
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-        case EVENT_TICK:
-            if (state->led_on_state == 1) {
-                watch_set_led_off();
-                state->led_on_state = 0;
-            }
-
-            switch (state->current_stage) {
-              case 0: {
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Breath", "Breath");
-                if (state->indication_mode != 2)
-                  breathe_notify(state, IN_NOTES, IN_DUR, 3, false);
-                break;
-              }
-              case 1:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   3", "In   3");
-                break;
-              case 2:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   2", "In   2");
-                break;
-              case 3:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "ln   1", "In   1");
-                break;
-
-              case 4: {
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 4", "Hold 4");
-                if (state->indication_mode != 2)
-                  breathe_notify(state, IN_HOLD_NOTES, IN_HOLD_DUR, 3, true);
-                break;
-              }
-              case 5:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 3", "Hold 3");
-                break;
-              case 6:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 2", "Hold 2");
-                break;
-              case 7:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 1", "Hold 1");
-                break;
-
-              case 8: {
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  4", "Ou t 4");
-                if (state->indication_mode != 2)
-                  breathe_notify(state, OUT_NOTES, OUT_DUR, 3, false);
-                break;
-              }
-              case 9:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  3", "Ou t 3");
-                break;
-              case 10:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  2", "Ou t 2");
-                break;
-              case 11:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Out  1", "Ou t 1");
-                break;
-
-              case 12: {
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 4", "Hold 4");
-                if (state->indication_mode != 2)
-                  breathe_notify(state, OUT_HOLD_NOTES, OUT_HOLD_DUR, 3, true);
-                break;
-              }
-              case 13:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 3", "Hold 3");
-                break;
-              case 14:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 2", "Hold 2");
-                break;
-              case 15:
-                watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Hold 1", "Hold 1");
-                break;
-              default:
-                break;
-            }
-
-            // and increment it so that it will update on the next tick.
-            state->current_stage = (state->current_stage + 1) % 16;
-
+            display_stage(state->current_stage);
+            break;
+        case EVENT_BEAT:
+            // the beat engine counts through the sixteen stages for us.
+            state->current_stage = event.subsecond;
+            display_stage(state->current_stage);
             break;
         case EVENT_ALARM_BUTTON_UP:
             // Cycle through the indication modes
             state->indication_mode = (state->indication_mode + 1) % 3;
             update_indicators(state);
+            // this starts the session over from the top, in the new mode.
+            movement_start_beats(&PATTERNS[state->indication_mode]);
             break;
         case EVENT_LOW_ENERGY_UPDATE:
-            // We don't want to go to sleep while we're breathing.
+            // Movement stays awake while the beats run, but just in case: we don't want to sleep while we're breathing.
             movement_request_wake();
             break;
         case EVENT_TIMEOUT:
@@ -198,5 +197,6 @@ bool breathing_face_loop(movement_event_t event, void *context) {
 
 void breathing_face_resign(void *context) {
     (void) context; // Silence unused parameter warning
-    watch_set_led_off();
+    movement_stop_beats();
+    movement_force_led_off();
 }
@@ -33,7 +33,9 @@
  * concentration in stressful situations.
  *
  * Usage: Timed messages will cycle as long as this face is active.
- * Press ALARM to toggle between sound and LED indication for phases.
+ * Press ALARM to toggle between sound and LED indication for phases;
+ * this starts the cycle over. The phases are timed by Movement's beat
+ * engine, so they keep to the second however long the session runs.
  */
 
 #include "movement.h"
@@ -33,6 +33,7 @@
 #define CD_SELECTIONS 3
 #define DEFAULT_MINUTES 3
 #define TAP_DETECTION_SECONDS 5
+#define CD_TIMER_ID 0
 
 static bool quick_ticks_running;
 
@@ -74,11 +75,10 @@ static void schedule_countdown(countdown_state_t *state) {
 
     // Calculate the new state->now_ts but don't update it until we've updated the target - 
     // avoid possible race where the old target is compared to the new time and immediately triggers
-    uint32_t new_now = watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), movement_get_current_timezone_offset());
+    uint32_t new_now = movement_get_utc_timestamp();
     state->target_ts = watch_utility_offset_timestamp(new_now, state->hours, state->minutes, state->seconds);
     state->now_ts = new_now;
-    watch_date_time_t target_dt = watch_utility_date_time_from_unix_time(state->target_ts, movement_get_current_timezone_offset());
-    movement_schedule_background_task_for_face(state->watch_face_index, target_dt);
+    movement_timer_start(state->watch_face_index, CD_TIMER_ID, state->target_ts);
 }
 
 static void auto_repeat(countdown_state_t *state) {
@@ -98,7 +98,7 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
     char buf[16];
 
     uint32_t delta;
-    div_t result;
+    watch_duration_t remaining;
 
     switch (state->mode) {
         case cd_running:
@@ -106,12 +106,11 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
                 delta = 0;
             else
                 delta = state->target_ts - state->now_ts;
-            result = div(delta, 60);
-            state->seconds = result.rem;
-            result = div(result.quot, 60);
-            state->hours = result.quot;
-            state->minutes = result.rem;
-            sprintf(buf, "%2d%02d%02d", state->hours, state->minutes, state->seconds);
+            remaining = watch_utility_seconds_to_duration(delta);
+            state->seconds = remaining.seconds;
+            state->minutes = remaining.minutes;
+            state->hours = remaining.hours;
+            movement_timer_format_remaining(buf, delta);
             break;
         case cd_reset:
         case cd_paused:
@@ -149,13 +148,13 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
 
 static void pause(countdown_state_t *state) {
     state->mode = cd_paused;
-    movement_cancel_background_task_for_face(state->watch_face_index);
+    movement_timer_cancel(state->watch_face_index, CD_TIMER_ID);
     watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
 }
 
 static void reset(countdown_state_t *state) {
     state->mode = cd_reset;
-    movement_cancel_background_task_for_face(state->watch_face_index);
+    movement_timer_cancel(state->watch_face_index, CD_TIMER_ID);
     load_countdown(state);
 }
 
@@ -202,14 +201,20 @@ void countdown_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         state->mode = cd_reset;
         state->watch_face_index = watch_face_index;
         store_countdown(state);
+
+        // if we were counting down before a reset, the timer service still is.
+        if (movement_timer_is_running(watch_face_index, CD_TIMER_ID)) {
+            state->target_ts = movement_timer_get_target(watch_face_index, CD_TIMER_ID);
+            state->now_ts = movement_get_utc_timestamp();
+            state->mode = cd_running;
+        }
     }
 }
 
 void countdown_face_activate(void *context) {
     countdown_state_t *state = (countdown_state_t *)context;
     if(state->mode == cd_running) {
-        watch_date_time_t now = movement_get_utc_date_time();
-        state->now_ts = watch_utility_date_time_to_unix_time(now, movement_get_current_timezone_offset());
+        state->now_ts = movement_get_utc_timestamp();
         watch_set_indicator(WATCH_INDICATOR_SIGNAL);
     }
     watch_set_colon();
@@ -347,7 +352,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
         case EVENT_ALARM_LONG_UP:
             abort_quick_ticks(state);
             break;
-        case EVENT_BACKGROUND_TASK:
+        case EVENT_TIMER_EXPIRED:
             times_up(state);
             break;
         case EVENT_TIMEOUT:
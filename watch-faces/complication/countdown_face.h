@@ -38,8 +38,8 @@
  *
  * Max countdown is 23 hours, 59 minutes and 59 seconds.
  *
- * Note: we have to prevent the watch from going to deep sleep using
- * movement_schedule_background_task() while the timer is running.
+ * The countdown runs on Movement's timer service, so it keeps going in low
+ * energy mode, and survives a reset of the watch.
  */
 
 #include "movement.h"
@@ -32,6 +32,7 @@
 #include "watch_utility.h"
 #include "watch_rtc.h"
 #include "slcd.h"
+#include "filesystem.h"
 
 /*
     This watch face implements the original F-91W stopwatch functionality
@@ -57,28 +58,30 @@ static inline void _button_beep() {
     if (movement_button_should_sound()) watch_buzzer_play_note_with_volume(BUZZER_NOTE_C7, 50, movement_button_volume());
 }
 
+#define FAST_STOPWATCH_LAPS_FILE "stw_laps.u32"
+
 // How quickly should the elapsing time be displayed?
-// This is just for looks, timekeeping is always accurate to 128Hz
+// This is just for looks, timekeeping is always accurate to WATCH_CAPTURE_HZ
 static const uint8_t DISPLAY_RUNNING_RATE = 32;
 static const uint8_t DISPLAY_RUNNING_RATE_SLOW = 2;
 
-/// @brief Display minutes, seconds and fractions derived from 128 Hz tick counter
+/// @brief Display minutes, seconds and fractions derived from WATCH_CAPTURE_HZ tick counter
 ///        on the lcd.
 /// @param ticks
 static void _display_elapsed(fast_stopwatch_state_t *state, uint32_t ticks) {
     char buf[3];
 
-    if (state->slow_refresh && (state->status == SW_STATUS_RUNNING || state->status == SW_STATUS_IDLE)) {
+    if (state->slow_refresh && (state->status == SW_STATUS_RUNNING || (state->status == SW_STATUS_IDLE && !state->review_lap))) {
         watch_display_character_lp_seconds(' ', 8);
         watch_display_character_lp_seconds(' ', 9);
     } else {
-        uint8_t sec_100 = (ticks & 0x7F) * 100 / 128;
+        uint8_t sec_100 = (ticks % WATCH_CAPTURE_HZ) * 100 / WATCH_CAPTURE_HZ;
 
         watch_display_character_lp_seconds('0' + sec_100 / 10, 8);
         watch_display_character_lp_seconds('0' + sec_100 % 10, 9);
     }
 
-    uint32_t seconds = ticks >> 7;
+    uint32_t seconds = ticks / WATCH_CAPTURE_HZ;
 
     if (seconds == state->old_display.seconds) {
         return;
@@ -117,13 +120,13 @@ static void _display_elapsed(fast_stopwatch_state_t *state, uint32_t ticks) {
 }
 
 static void _draw_indicators(fast_stopwatch_state_t *state, movement_event_t event, uint32_t elapsed) {
-    uint8_t subsecond;
+    uint16_t subsecond;
     bool tock;
 
     switch (state->status) {
         case SW_STATUS_RUNNING:
-            subsecond = elapsed & 127;
-            tock = subsecond >= 64;
+            subsecond = elapsed % WATCH_CAPTURE_HZ;
+            tock = subsecond >= WATCH_CAPTURE_HZ / 2;
 
             watch_clear_indicator(WATCH_INDICATOR_LAP);
             if (tock) {
@@ -153,8 +156,16 @@ static void _draw_indicators(fast_stopwatch_state_t *state, movement_event_t eve
 
             return;
 
-        case SW_STATUS_STOPPED:
         case SW_STATUS_IDLE:
+            if (state->review_lap) {
+                watch_set_indicator(WATCH_INDICATOR_LAP);
+            } else {
+                watch_clear_indicator(WATCH_INDICATOR_LAP);
+            }
+            watch_set_colon();
+            return;
+
+        case SW_STATUS_STOPPED:
         default:
             watch_clear_indicator(WATCH_INDICATOR_LAP);
             watch_set_colon();
@@ -162,6 +173,44 @@ static void _draw_indicators(fast_stopwatch_state_t *state, movement_event_t eve
     }
 }
 
+static void _draw_title(fast_stopwatch_state_t *state) {
+    if (state->status == SW_STATUS_IDLE && state->review_lap) {
+        char buf[3];
+        watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LAP", "LP");
+        sprintf(buf, "%2d", state->review_lap);
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+    } else {
+        watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "STW", "ST");
+    }
+}
+
+// The lap number goes where the hours do, so force a full redraw whenever it comes or goes.
+static void _set_review_lap(fast_stopwatch_state_t *state, uint8_t lap) {
+    state->review_lap = lap;
+    state->old_display.seconds = UINT_MAX;
+    state->old_display.minutes = UINT_MAX;
+    state->old_display.hours = UINT_MAX;
+}
+
+static uint8_t _saved_laps(void) {
+    int32_t size = filesystem_get_file_size(FAST_STOPWATCH_LAPS_FILE);
+    if (size <= 0) return 0;
+    return size / sizeof(uint32_t);
+}
+
+// Each lap is saved as it's taken, as four bytes of elapsed time, so a run's laps survive a reset of the watch.
+static void _save_lap(fast_stopwatch_state_t *state) {
+    uint32_t elapsed = state->lap_counter - state->start_counter;
+    if (_saved_laps() >= FAST_STOPWATCH_MAX_LAPS) return;
+    filesystem_append_file(FAST_STOPWATCH_LAPS_FILE, (char *)&elapsed, sizeof(elapsed));
+}
+
+static uint32_t _load_lap(uint8_t lap) {
+    uint32_t elapsed = 0;
+    filesystem_read_file_at(FAST_STOPWATCH_LAPS_FILE, (char *)&elapsed, (lap - 1) * sizeof(uint32_t), sizeof(elapsed));
+    return elapsed;
+}
+
 static uint8_t get_refresh_rate(fast_stopwatch_state_t *state) {
     switch (state->status) {
         case SW_STATUS_RUNNING:
@@ -179,16 +228,29 @@ static uint8_t get_refresh_rate(fast_stopwatch_state_t *state) {
     }
 }
 
-static void state_transition(fast_stopwatch_state_t *state, rtc_counter_t counter, movement_event_type_t event_type) {
+static void state_transition(fast_stopwatch_state_t *state, uint32_t counter, movement_event_type_t event_type) {
     switch (state->status) {
         case SW_STATUS_IDLE:
             switch (event_type) {
                 case EVENT_ALARM_BUTTON_DOWN:
                     state->status = SW_STATUS_RUNNING;
                     state->start_counter = counter;
+                    _set_review_lap(state, 0);
+                    // a new run starts a new list of laps
+                    filesystem_rm(FAST_STOPWATCH_LAPS_FILE);
                     movement_request_tick_frequency(get_refresh_rate(state));
                     return;
+                case EVENT_LIGHT_BUTTON_DOWN:
+                    state->review_armed = true;
+                    return;
+                case EVENT_LIGHT_BUTTON_UP:
+                    if (state->review_armed) {
+                        state->review_armed = false;
+                        _set_review_lap(state, state->review_lap < _saved_laps() ? state->review_lap + 1 : 0);
+                    }
+                    return;
                 case EVENT_LIGHT_LONG_PRESS:
+                    state->review_armed = false;
                     state->slow_refresh = !state->slow_refresh;
                     return;
                 default:
@@ -205,6 +267,7 @@ static void state_transition(fast_stopwatch_state_t *state, rtc_counter_t counte
                 case EVENT_LIGHT_BUTTON_DOWN:
                     state->status = SW_STATUS_RUNNING_LAPPING;
                     state->lap_counter = counter;
+                    _save_lap(state);
                     movement_request_tick_frequency(get_refresh_rate(state));
                     return;
                 default:
@@ -221,6 +284,7 @@ static void state_transition(fast_stopwatch_state_t *state, rtc_counter_t counte
                 case EVENT_LIGHT_BUTTON_DOWN:
                     state->status = SW_STATUS_RUNNING;
                     state->lap_counter = counter;
+                    _save_lap(state);
                     movement_request_tick_frequency(get_refresh_rate(state));
                     return;
                 case EVENT_LIGHT_LONG_PRESS:
@@ -266,10 +330,10 @@ static void state_transition(fast_stopwatch_state_t *state, rtc_counter_t counte
     }
 }
 
-static uint32_t elapsed_time(fast_stopwatch_state_t *state, rtc_counter_t counter) {
+static uint32_t elapsed_time(fast_stopwatch_state_t *state, uint32_t counter) {
     switch (state->status) {
         case SW_STATUS_IDLE:
-            return 0;
+            return state->review_lap ? _load_lap(state->review_lap) : 0;
 
         case SW_STATUS_RUNNING:
             return counter - state->start_counter;
@@ -305,32 +369,45 @@ void fast_stopwatch_face_activate(void *context) {
     state->old_display.seconds = UINT_MAX;
     state->old_display.minutes = UINT_MAX;
     state->old_display.hours = UINT_MAX;
+    state->review_armed = false;
+    movement_enable_button_capture();
     movement_request_tick_frequency(get_refresh_rate(state));
 }
 
 bool fast_stopwatch_face_loop(movement_event_t event, void *context) {
     fast_stopwatch_state_t *state = (fast_stopwatch_state_t *)context;
 
-    rtc_counter_t counter = watch_rtc_get_counter();
+    // Button events carry the time captured at the button edge, so start/stop/lap times
+    // don't include the latency between the interrupt and this loop being called.
+    uint32_t counter = movement_get_button_event_capture(event.event_type);
 
     state_transition(state, counter, event.event_type);
-    rtc_counter_t elapsed = elapsed_time(state, counter);
+    uint32_t elapsed = elapsed_time(state, counter);
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "STW", "ST");
             _draw_indicators(state, event, elapsed);
             _display_elapsed(state, elapsed);
+            _draw_title(state);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
         case EVENT_LIGHT_BUTTON_DOWN:
         case EVENT_LIGHT_LONG_PRESS:
             _button_beep();
-            // fall through
+            _draw_indicators(state, event, elapsed);
+            _display_elapsed(state, elapsed);
+            _draw_title(state);
+            break;
         case EVENT_TICK:
             _draw_indicators(state, event, elapsed);
             _display_elapsed(state, elapsed);
             break;
+        case EVENT_LIGHT_BUTTON_UP:
+            _draw_indicators(state, event, elapsed);
+            _display_elapsed(state, elapsed);
+            _draw_title(state);
+            movement_default_loop_handler(event);
+            break;
         default:
             movement_default_loop_handler(event);
             break;
@@ -341,5 +418,7 @@ bool fast_stopwatch_face_loop(movement_event_t event, void *context) {
 
 void fast_stopwatch_face_resign(void *context) {
     (void) context;
+    // captures line up with the RTC, so a run can go on in the background without them
+    movement_disable_button_capture();
     movement_request_tick_frequency(1);
 }
@@ -37,6 +37,12 @@
  * Press the LIGHT button again to switch back to the running stopwatch.
  * Press the LIGHT button when the timekeeping is stopped to reset the stopwatch.
  *
+ * Button presses are timestamped by a hardware timer at the button edge, to
+ * about a millisecond. Lap times are saved to the file stw_laps.u32, which
+ * holds the laps of the last run. With the stopwatch reset, press and release
+ * the LIGHT button to step through them (LAP, lap number in the upper right);
+ * press it after the last one to go back.
+ *
  * There are two improvements compared to the original F-91W:
  *  o When the stopwatch reaches 59:59, the counter does not simply jump back
  *    to zero but keeps track of hours in the upper right-hand corner
@@ -54,12 +60,18 @@
 
 #include "movement.h"
 
+// The most laps a run saves; later ones are shown but not saved.
+#define FAST_STOPWATCH_MAX_LAPS 99
+
 typedef struct {
-    rtc_counter_t start_counter; // rtc counter when the stopwatch was started
-    rtc_counter_t lap_counter;   // rtc counter when the stopwatch was lapped
-    rtc_counter_t stop_counter;  // rtc counter when the stopwatch was stopped
+    // These are in 1/WATCH_CAPTURE_HZ seconds, from movement_get_button_event_capture.
+    uint32_t start_counter;      // when the stopwatch was started
+    uint32_t lap_counter;        // when the stopwatch was lapped
+    uint32_t stop_counter;       // when the stopwatch was stopped
     uint8_t status;              // the status the stopwatch is in (idle, running, stopped)
-    bool slow_refresh;           // update the display slowly (same 128Hz timekeeping accuracy)
+    uint8_t review_lap;          // the saved lap on display while reset, or 0 for none
+    bool review_armed;           // the light button went down while reset, so its release steps through the laps
+    bool slow_refresh;           // update the display slowly (same timekeeping accuracy)
     struct {
         rtc_counter_t seconds;
         rtc_counter_t minutes;
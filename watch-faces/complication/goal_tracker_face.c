@@ -1,605 +1,460 @@
-// watch_faces/complication/goal_tracker_face.c
-// SENSOR WATCH PRO - GOAL TRACKER FACE (extensively commented)
-// - Upgraded LCD: top row shows "A:### B:##", main shows time.
-// - Non-volatile tallies and goals (A supports up to 3 digits via 16-bit storage).
-// - Increment = 2s hold; Reset = 5s hold (single action per hold).
-// - Single tap (LIS2DW) -> GET A (if behind).
-// - Double tap (LIS2DW) -> GET B (if behind).
-// - Triple tap -> SET mode toggle (Option 3): first triple-tap -> SET A, next triple-tap -> SET B, etc.
-// - Deficit uses real days-in-month (incl. leap years) and displays with 2 decimal places.
-// - Uses lis2dw driver: lis2dw_get_int_source(), lis2dw_get_accel(...).
-// - Uses movement/watch helpers: movement_get_local_time(), movement_is_button_pressed(),
-//   movement_request_tick_frequency(), watch_display_string(), watch_display_time(),
-//   watch_get_backup_data(), watch_store_backup_data().
-//
-// Extensive inline comments explain the logic and where to tweak parameters.
-
-#include "movement.h"
-#include "watch.h"
-#include "watch_private_display.h"
-#include "lis2dw.h"   // sensor driver in repo: watch-library/shared/driver/lis2dw.*
-#include <stdbool.h>
-#include <stdint.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
-#include <time.h>
-
-/* ===== ADD THE FORWARD DECLARATIONS HERE ===== */
-void goal_tracker_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr);
-void goal_tracker_face_activate(movement_settings_t *settings, void *context);
-bool goal_tracker_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
-void goal_tracker_face_resign(movement_settings_t *settings, void *context);
-/* ============================================== */
-
-/* ------------------------- STORAGE (backup SRAM) -------------------------
-   The Sensor Watch exposes small backup SRAM (32 bytes). Each watch_get_backup_data /
-   watch_store_backup_data call reads/writes one byte.
-
-   Because you requested Tally A to support triple digits, we store 16-bit values
-   for Tally A and Goal A across two consecutive backup slots (low byte then high byte).
-
-   Layout (byte indices):
-     0 - TALLY_A low
-     1 - TALLY_A high
-     2 - TALLY_B low  (fits in one byte but keep symmetry)
-     3 - TALLY_B high (unused for B but reserved; we'll store 0)
-     4 - GOAL_A low
-     5 - GOAL_A high
-     6 - GOAL_B low
-     7 - GOAL_B high
-   Remaining bytes available if you later want more persistent vars.
--------------------------------------------------------------------------*/
-
-#define BK_TALLY_A_LO 0
-#define BK_TALLY_A_HI 1
-#define BK_TALLY_B_LO 2
-#define BK_TALLY_B_HI 3
-#define BK_GOAL_A_LO  4
-#define BK_GOAL_A_HI  5
-#define BK_GOAL_B_LO  6
-#define BK_GOAL_B_HI  7
-
-/* Default goals (can be changed on-watch) */
-#define GOAL_A_DEFAULT 12    // user said 12 for A
-#define GOAL_B_DEFAULT 4     // user said 4 for B
-
-/* Min/max constraints */
+#include "goal_tracker_face.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#define GOAL_A_DEFAULT 12
+#define GOAL_B_DEFAULT 4
+
 #define MIN_GOAL 1
-#define MAX_GOAL_A 999       // A supports up to 3 digits
-#define MAX_GOAL_B 99        // B limited to 2 digits on LCD
+#define MAX_GOAL_A 999  // A gets three digits on the custom LCD
+#define MAX_GOAL_B 99
+
+#define GET_SHOW_SECONDS 3
+// tap detection runs the accelerometer at 400 Hz, so only keep it on for a while after the last interaction
+#define TAP_DETECTION_SECONDS 30
+// three single taps within this many RTC ticks (1.5 seconds) make a triple tap
+#define TRIPLE_TAP_WINDOW_TICKS 192
+
+// Movement timer id used for pace-crossing alerts
+#define PACE_TIMER_ID 0
+// local hour at which a pace-crossing alert goes off, on the day it happens
+#ifndef GOAL_TRACKER_PACE_ALERT_HOUR
+#define GOAL_TRACKER_PACE_ALERT_HOUR 9
+#endif
 
-/* Action timing (seconds) */
-#define HOLD_INC_SECONDS   2   // hold time to increment
-#define HOLD_RESET_SECONDS 5   // hold time to reset (overrides increment)
-#define GET_SHOW_SECONDS   3   // how long GET display remains
+static inline void _goal_tracker_beep(void) {
+    if (movement_button_should_sound()) watch_buzzer_play_note_with_volume(BUZZER_NOTE_C7, 50, movement_button_volume());
+}
 
-/* Tap / gesture timing (ms) */
-#define TRIPLE_TAP_WINDOW_MS 1500 // window for counting up to 3 single taps
-#define TAP_DEBOUNCE_MS      250  // after confirmed gesture ignore further taps briefly
+static void _goal_tracker_load(goal_tracker_state_t *state) {
+    uint32_t tallies = state->tallies_backup_register ? watch_get_backup_data(state->tallies_backup_register) : 0;
+    uint32_t goals = state->goals_backup_register ? watch_get_backup_data(state->goals_backup_register) : 0;
 
-/* Display indexes (usual convention for upgraded LCD) */
-#define TOP_DISPLAY_INDEX 0
-#define MAIN_DISPLAY_INDEX 1
+    state->tally_a = tallies & 0xFFFF;
+    state->tally_b = tallies >> 16;
+    state->goal_a = goals & 0xFFFF;
+    state->goal_b = goals >> 16;
 
-/* Tap source bits from lis2dw.h; define fallback if header didn't */
-#ifndef LIS2DW_TAP_SRC_SINGLE_TAP
-#define LIS2DW_TAP_SRC_SINGLE_TAP (1 << 6)
-#endif
-#ifndef LIS2DW_TAP_SRC_DOUBLE_TAP
-#define LIS2DW_TAP_SRC_DOUBLE_TAP (1 << 5)
-#endif
+    if (state->tally_a > MAX_GOAL_A) state->tally_a = 0;
+    if (state->tally_b > MAX_GOAL_B) state->tally_b = 0;
+    if (state->goal_a < MIN_GOAL || state->goal_a > MAX_GOAL_A) state->goal_a = GOAL_A_DEFAULT;
+    if (state->goal_b < MIN_GOAL || state->goal_b > MAX_GOAL_B) state->goal_b = GOAL_B_DEFAULT;
+}
+
+static void _goal_tracker_store(goal_tracker_state_t *state) {
+    if (state->tallies_backup_register) {
+        watch_store_backup_data(state->tally_a | ((uint32_t)state->tally_b << 16), state->tallies_backup_register);
+    }
+    if (state->goals_backup_register) {
+        watch_store_backup_data(state->goal_a | ((uint32_t)state->goal_b << 16), state->goals_backup_register);
+    }
+}
 
-/* ------------------------- Helper: multi-byte backup I/O -------------------------
-   Read and write 16-bit values across two backup byte slots (little-endian).
--------------------------------------------------------------------------*/
-static uint16_t backup_read_u16(uint8_t lo_index, uint8_t hi_index) {
-    uint8_t lo = watch_get_backup_data(lo_index);
-    uint8_t hi = watch_get_backup_data(hi_index);
-    return (uint16_t)lo | ((uint16_t)hi << 8);
+/* Expected progress is linear in the day of month, so rather than polling the
+ * deficit we can solve for the day on which it next grows by a whole unit:
+ *   level = floor((goal * day - actual * dim) / dim)        (0 if ahead)
+ *   next  = ceil((actual + level + 1) * dim / goal)
+ * Expected progress only steps at local midnight, so we arm one Movement timer
+ * for GOAL_TRACKER_PACE_ALERT_HOUR on the sooner of A's and B's next crossing
+ * days, rather than buzzing at midnight. If neither crosses this month, we wake
+ * on the 1st and look again. This only needs redoing when a tally or goal
+ * changes, or the timer fires.
+ */
+static uint16_t _goal_tracker_deficit_level(uint16_t goal, uint16_t actual, uint8_t day, uint8_t dim) {
+    int32_t behind = (int32_t)goal * day - (int32_t)actual * dim;
+    return behind > 0 ? behind / dim : 0;
 }
 
-static void backup_write_u16(uint8_t lo_index, uint8_t hi_index, uint16_t value) {
-    uint8_t lo = (uint8_t)(value & 0xFF);
-    uint8_t hi = (uint8_t)((value >> 8) & 0xFF);
-    watch_store_backup_data(lo_index, lo);
-    watch_store_backup_data(hi_index, hi);
+static uint32_t _goal_tracker_next_crossing_day(uint16_t goal, uint16_t actual, uint16_t level, uint8_t dim) {
+    uint32_t threshold = (uint32_t)(actual + level + 1) * dim;
+    return (threshold + goal - 1) / goal;
 }
 
-/* ------------------------- Date helpers (days in month, leap year) -------------
-   We use the RTC to determine current day/month/year and compute expected progress:
-     expected = goal * (day_of_month / days_in_month)
-   Deficit = expected - actual (if >0)
--------------------------------------------------------------------------------*/
-static uint8_t days_in_month(uint16_t year, uint8_t month) {
-    static const uint8_t mdays[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
-    if (month != 2) return mdays[month - 1];
-    bool leap = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
-    return leap ? 29 : 28;
+static void _goal_tracker_schedule_pace_alert(goal_tracker_state_t *state) {
+    watch_date_time_t today = movement_get_local_date_time();
+    uint8_t dim = watch_utility_days_in_month(today.unit.month, today.unit.year + WATCH_RTC_REFERENCE_YEAR);
+
+    state->pace_level_a = _goal_tracker_deficit_level(state->goal_a, state->tally_a, today.unit.day, dim);
+    state->pace_level_b = _goal_tracker_deficit_level(state->goal_b, state->tally_b, today.unit.day, dim);
+
+    uint32_t day_a = _goal_tracker_next_crossing_day(state->goal_a, state->tally_a, state->pace_level_a, dim);
+    uint32_t day_b = _goal_tracker_next_crossing_day(state->goal_b, state->tally_b, state->pace_level_b, dim);
+    uint32_t day = day_a < day_b ? day_a : day_b;
+
+    watch_date_time_t target = today;
+    target.unit.hour = GOAL_TRACKER_PACE_ALERT_HOUR;
+    target.unit.minute = 0;
+    target.unit.second = 0;
+    if (day > dim) {
+        target.unit.day = 1;
+        if (target.unit.month == 12) {
+            target.unit.month = 1;
+            target.unit.year++;
+        } else {
+            target.unit.month++;
+        }
+    } else {
+        target.unit.day = day;
+    }
+
+    movement_timer_start(state->watch_face_index, PACE_TIMER_ID,
+                         watch_utility_date_time_to_unix_time(target, movement_get_current_timezone_offset()));
 }
 
-/* fetch current date using movement helper (common in sensor-watch builds)
-   returns true on success and fills year/month/day */
-static bool get_current_date(uint16_t *year, uint8_t *month, uint8_t *day) {
-    struct tm now;
-    if (movement_get_local_time(&now)) {
-        *year = (uint16_t)(now.tm_year + 1900);
-        *month = (uint8_t)(now.tm_mon + 1);
-        *day = (uint8_t)now.tm_mday;
-        return true;
+static void _goal_tracker_check_pace(goal_tracker_state_t *state) {
+    uint16_t last_level_a = state->pace_level_a;
+    uint16_t last_level_b = state->pace_level_b;
+
+    _goal_tracker_schedule_pace_alert(state);
+
+    bool fell_behind_a = state->pace_level_a > last_level_a;
+    bool fell_behind_b = state->pace_level_b > last_level_b;
+    if (fell_behind_a || fell_behind_b) {
+        if (!movement_in_quiet_hours()) movement_play_signal();
+        state->mode = fell_behind_a ? GOAL_TRACKER_MODE_GET_A : GOAL_TRACKER_MODE_GET_B;
+        state->get_seconds_remaining = GET_SHOW_SECONDS;
+        state->top_dirty = true;
     }
-    return false;
 }
 
-/* Compute deficit for given goal and actual tally using real month length.
-   If RTC unavailable, return 0.0f (no alert) to avoid false GETs. */
-static float compute_deficit(uint16_t goal, uint16_t actual) {
-    uint16_t yr; uint8_t mo; uint8_t dy;
-    if (!get_current_date(&yr, &mo, &dy)) {
-        return 0.0f; // conservative: don't alert when date is unknown
+// how far behind pace a tally is right now, in units (0 if on or ahead of pace)
+static float _goal_tracker_deficit(uint16_t goal, uint16_t actual) {
+    watch_date_time_t today = movement_get_local_date_time();
+    uint8_t dim = watch_utility_days_in_month(today.unit.month, today.unit.year + WATCH_RTC_REFERENCE_YEAR);
+    float deficit = (float)goal * today.unit.day / dim - actual;
+
+    return deficit > 0 ? deficit : 0;
+}
+
+static void _goal_tracker_changed(goal_tracker_state_t *state) {
+    _goal_tracker_store(state);
+    _goal_tracker_schedule_pace_alert(state);
+    state->top_dirty = true;
+}
+
+static void _goal_tracker_show_get(goal_tracker_state_t *state, goal_tracker_mode_t mode) {
+    // only worth showing if we're actually behind
+    if ((mode == GOAL_TRACKER_MODE_GET_A && _goal_tracker_deficit(state->goal_a, state->tally_a) > 0) ||
+        (mode == GOAL_TRACKER_MODE_GET_B && _goal_tracker_deficit(state->goal_b, state->tally_b) > 0)) {
+        state->mode = mode;
+        state->get_seconds_remaining = GET_SHOW_SECONDS;
+        state->top_dirty = true;
     }
-    uint8_t dim = days_in_month(yr, mo);
-    float expected = ((float)goal) * ((float)dy / (float)dim);
-    float deficit = expected - (float)actual;
-    if (deficit < 0.0f) deficit = 0.0f;
-    return deficit;
 }
 
-/* ------------------------- State struct -------------------------
-   All runtime state for the face lives here.
--------------------------------------------------------------------------*/
-typedef enum {
-    MODE_NORMAL = 0,
-    MODE_SHOW_GET,
-    MODE_SET_A,
-    MODE_SET_B
-} face_mode_t;
-
-typedef struct {
-    uint16_t tally_a;
-    uint16_t tally_b;
-    uint16_t goal_a;
-    uint16_t goal_b;
-
-    /* hold counters (seconds) while button is held */
-    uint8_t hold_seconds_a;
-    uint8_t hold_seconds_b;
-
-    /* prevent multiple actions during a single long hold */
-    bool action_done_during_hold_a;
-    bool action_done_during_hold_b;
-
-    /* gesture/tap tracking (ms clock updated on ticks) */
-    uint32_t ms_clock;
-    uint32_t last_tap_ms;        // time of last tap detected
-    uint8_t tap_count;           // number of single taps counted in current window
-    uint32_t last_gesture_ms;    // when we last handled a gesture (for debounce)
-
-    /* GET display state */
-    face_mode_t mode;
-    uint8_t get_seconds_remaining; // countdown in seconds
-
-} goal_tracker_face_state_t;
-
-/* forward declarations required by framework */
-void goal_tracker_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr);
-void goal_tracker_face_activate(movement_settings_t *settings, void *context);
-bool goal_tracker_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
-void goal_tracker_face_resign(movement_settings_t *settings, void *context);
-
-/* ------------------------- Helper: top-row renderer -------------------------
-   Compose the top line string "A:### B:##" according to current tallies.
-   A uses 3 digits (padded); B uses 2 digits (padded).
--------------------------------------------------------------------------*/
-static void render_top_line(goal_tracker_face_state_t *st, char *buf, size_t buflen) {
-    // Example: "A:012 B:04"
-    // Use %03u for A and %02u for B to maintain alignment
-    snprintf(buf, buflen, "A:%03u B:%02u", (unsigned)st->tally_a, (unsigned)st->tally_b);
+static void _goal_tracker_set_mode(goal_tracker_state_t *state, goal_tracker_mode_t mode) {
+    state->mode = mode;
+    state->top_dirty = true;
+}
+
+static void _goal_tracker_keep_tap_detection(goal_tracker_state_t *state) {
+    if (state->tap_detection_ticks == 0 && !movement_enable_tap_detection_if_available()) return;
+    state->tap_detection_ticks = TAP_DETECTION_SECONDS;
 }
 
-/* ------------------------- Gesture handling helpers -------------------------
-   We use the LIS2DW driver:
-     - lis2dw_get_int_source() returns the sensor INT_SRC/TAP_SRC register bits
-       (we check SINGLE_TAP and DOUBLE_TAP bits).
-     - lis2dw_get_accel(&x,&y,&z) exists but is NOT required for tap bits; we rely on int source.
-
-   Gesture policy:
-     - If DOUBLE_TAP bit is set -> immediate double-tap action (GET B)
-     - If SINGLE_TAP bit is set -> accumulate into a tap_count and evaluate:
-         * if we reach 3 single taps within TRIPLE_TAP_WINDOW_MS -> treat as triple-tap
-         * if the window expires (no more single taps) -> treat as single-tap
-     - Debounce: after any confirmed gesture, ignore further gestures for TAP_DEBOUNCE_MS.
--------------------------------------------------------------------------*/
-
-/* Called when we decide a single-tap gesture is confirmed (after window expires) */
-static void do_single_tap_action(goal_tracker_face_state_t *st) {
-    // Single tap = GET A (priority)
-    float def = compute_deficit(st->goal_a, st->tally_a);
-    if (def > 0.0001f) {
-        st->mode = MODE_SHOW_GET;
-        st->get_seconds_remaining = GET_SHOW_SECONDS;
+static void _goal_tracker_abort_tap_detection(goal_tracker_state_t *state) {
+    if (state->tap_detection_ticks) movement_disable_tap_detection_if_available();
+    state->tap_detection_ticks = 0;
+    state->tap_count = 0;
+}
+
+static void _goal_tracker_handle_single_tap(goal_tracker_state_t *state) {
+    rtc_counter_t counter = watch_rtc_get_counter();
+
+    if (state->tap_count && counter - state->last_tap_counter > TRIPLE_TAP_WINDOW_TICKS) state->tap_count = 0;
+    state->tap_count++;
+    state->last_tap_counter = counter;
+
+    if (state->tap_count == 3) {
+        // triple tap: SET A, then SET B on the next one
+        state->tap_count = 0;
+        _goal_tracker_set_mode(state, state->mode == GOAL_TRACKER_MODE_SET_A ? GOAL_TRACKER_MODE_SET_B : GOAL_TRACKER_MODE_SET_A);
     }
 }
 
-/* Called when double-tap is detected (driver provided immediate bit) */
-static void do_double_tap_action(goal_tracker_face_state_t *st) {
-    // Double tap = GET B (priority after A)
-    float def = compute_deficit(st->goal_b, st->tally_b);
-    if (def > 0.0001f) {
-        st->mode = MODE_SHOW_GET;
-        st->get_seconds_remaining = GET_SHOW_SECONDS;
+// a lone single tap only counts as GET A once the window for a triple tap has passed; checked on every tick.
+static void _goal_tracker_check_tap_window(goal_tracker_state_t *state) {
+    if (state->tap_count == 0 || watch_rtc_get_counter() - state->last_tap_counter <= TRIPLE_TAP_WINDOW_TICKS) return;
+
+    if (state->tap_count == 1 && state->mode == GOAL_TRACKER_MODE_NORMAL) {
+        _goal_tracker_show_get(state, GOAL_TRACKER_MODE_GET_A);
     }
+    state->tap_count = 0;
 }
 
-/* Called when triple-tap is detected */
-static void do_triple_tap_action(goal_tracker_face_state_t *st) {
-    // Option 3: triple-tap toggles between SET A and SET B.
-    // If currently normal -> enter SET A. If already SET A -> switch to SET B.
-    if (st->mode == MODE_SET_A) {
-        st->mode = MODE_SET_B;
-    } else {
-        st->mode = MODE_SET_A;
+static void _goal_tracker_draw_top(goal_tracker_state_t *state) {
+    char buf[6];
+    char fallback[3];
+
+    switch (state->mode) {
+        case GOAL_TRACKER_MODE_NORMAL:
+            sprintf(buf, "%3u", state->tally_a);
+            // the classic LCD only has two characters up there
+            if (state->tally_a > 99) strcpy(fallback, "--");
+            else sprintf(fallback, "%2u", state->tally_a);
+            watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, buf, fallback);
+            sprintf(buf, "%2u", state->tally_b);
+            watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+            break;
+        case GOAL_TRACKER_MODE_GET_A:
+            watch_display_text_with_fallback(WATCH_POSITION_TOP, "GET A", "GA");
+            break;
+        case GOAL_TRACKER_MODE_GET_B:
+            watch_display_text_with_fallback(WATCH_POSITION_TOP, "GET B", "GB");
+            break;
+        case GOAL_TRACKER_MODE_SET_A:
+            watch_display_text_with_fallback(WATCH_POSITION_TOP, "SET A", "SA");
+            break;
+        case GOAL_TRACKER_MODE_SET_B:
+            watch_display_text_with_fallback(WATCH_POSITION_TOP, "SET B", "SB");
+            break;
     }
 }
 
-/* ------------------------- Main face functions ------------------------- */
+// Draws the time on the main line, touching only the fields that changed since the last call.
+static void _goal_tracker_draw_time(goal_tracker_state_t *state, watch_date_time_t now, bool low_energy) {
+    char buf[7];
+    watch_date_time_t previous = state->previous;
 
-/* Setup: allocate state and load persistent values */
-void goal_tracker_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
-    (void)settings;
-    (void)watch_face_index;
+    // in low energy mode, the seconds aren't kept up to date, so the next regular draw has to start over.
+    state->previous.reg = low_energy ? 0 : now.reg;
 
-    if (*context_ptr == NULL) {
-        goal_tracker_face_state_t *st = malloc(sizeof(goal_tracker_face_state_t));
-        if (!st) return; // allocation failure - extremely unlikely on these builds
+    if (!low_energy && previous.reg && (now.reg >> 6) == (previous.reg >> 6)) {
+        sprintf(buf, "%02d", now.unit.second);
+        watch_display_text(WATCH_POSITION_SECONDS, buf);
+        return;
+    }
+
+    if (!low_energy && previous.reg && (now.reg >> 12) == (previous.reg >> 12)) {
+        sprintf(buf, "%02d%02d", now.unit.minute, now.unit.second);
+        watch_display_text(WATCH_POSITION_MINUTES, buf);
+        watch_display_text(WATCH_POSITION_SECONDS, buf + 2);
+        return;
+    }
+
+    movement_clock_mode_t clock_mode = movement_clock_mode_24h();
+    if (clock_mode == MOVEMENT_CLOCK_MODE_12H) {
+        if (now.unit.hour >= 12) watch_set_indicator(WATCH_INDICATOR_PM);
+        else watch_clear_indicator(WATCH_INDICATOR_PM);
+        now.unit.hour %= 12;
+        if (now.unit.hour == 0) now.unit.hour = 12;
+        watch_clear_indicator(WATCH_INDICATOR_24H);
+    } else {
+        watch_set_indicator(WATCH_INDICATOR_24H);
+    }
+
+    sprintf(buf, clock_mode == MOVEMENT_CLOCK_MODE_024H ? "%02d%02d%02d" : "%2d%02d%02d", now.unit.hour, now.unit.minute, now.unit.second);
+    if (low_energy) buf[4] = buf[5] = ' ';
+    watch_display_text(WATCH_POSITION_BOTTOM, buf);
+}
+
+static void _goal_tracker_draw(goal_tracker_state_t *state, bool low_energy) {
+    char buf[7];
+    bool mode_changed = state->top_dirty;
+
+    if (state->top_dirty) {
+        state->top_dirty = false;
+        _goal_tracker_draw_top(state);
+    }
 
-        /* load persistent tallies/goals from backup SRAM (u16 for A, u16 for B/goals) */
-        st->tally_a = backup_read_u16(BK_TALLY_A_LO, BK_TALLY_A_HI);
-        st->tally_b = backup_read_u16(BK_TALLY_B_LO, BK_TALLY_B_HI);
+    switch (state->mode) {
+        case GOAL_TRACKER_MODE_NORMAL:
+            if (mode_changed) {
+                // we may be coming back from a float or a goal; start over.
+                watch_clear_decimal_if_available();
+                watch_set_colon();
+                state->previous.reg = 0;
+            }
+            _goal_tracker_draw_time(state, movement_get_local_date_time(), low_energy);
+            break;
+        case GOAL_TRACKER_MODE_GET_A:
+        case GOAL_TRACKER_MODE_GET_B:
+            if (!mode_changed) break;
+            watch_clear_colon();
+            watch_clear_indicator(WATCH_INDICATOR_PM);
+            watch_clear_indicator(WATCH_INDICATOR_24H);
+            if (state->mode == GOAL_TRACKER_MODE_GET_A) {
+                watch_display_float_with_best_effort(_goal_tracker_deficit(state->goal_a, state->tally_a), NULL);
+            } else {
+                watch_display_float_with_best_effort(_goal_tracker_deficit(state->goal_b, state->tally_b), NULL);
+            }
+            break;
+        case GOAL_TRACKER_MODE_SET_A:
+        case GOAL_TRACKER_MODE_SET_B:
+            if (!mode_changed) break;
+            watch_clear_colon();
+            watch_clear_decimal_if_available();
+            watch_clear_indicator(WATCH_INDICATOR_PM);
+            watch_clear_indicator(WATCH_INDICATOR_24H);
+            sprintf(buf, "%4u  ", state->mode == GOAL_TRACKER_MODE_SET_A ? state->goal_a : state->goal_b);
+            watch_display_text(WATCH_POSITION_BOTTOM, buf);
+            break;
+    }
+}
 
-        uint16_t saved_goal_a = backup_read_u16(BK_GOAL_A_LO, BK_GOAL_A_HI);
-        uint16_t saved_goal_b = backup_read_u16(BK_GOAL_B_LO, BK_GOAL_B_HI);
+static void _goal_tracker_adjust_goal(goal_tracker_state_t *state, int8_t delta) {
+    uint16_t *goal = state->mode == GOAL_TRACKER_MODE_SET_A ? &state->goal_a : &state->goal_b;
+    uint16_t max_goal = state->mode == GOAL_TRACKER_MODE_SET_A ? MAX_GOAL_A : MAX_GOAL_B;
 
-        /* If backup memory uninitialized, watch_get_backup_data returns 0xFF per byte.
-           That would produce goal values maybe > MIN_GOAL or nonsense; handle fallback.
-           Simple rule: if saved_goal < MIN_GOAL or > MAX, use defaults. */
-        if (saved_goal_a < MIN_GOAL || saved_goal_a > MAX_GOAL_A) st->goal_a = GOAL_A_DEFAULT;
-        else st->goal_a = saved_goal_a;
+    if (delta > 0 && *goal < max_goal) (*goal)++;
+    else if (delta < 0 && *goal > MIN_GOAL) (*goal)--;
+    else return;
 
-        if (saved_goal_b < MIN_GOAL || saved_goal_b > MAX_GOAL_B) st->goal_b = GOAL_B_DEFAULT;
-        else st->goal_b = saved_goal_b;
+    _goal_tracker_changed(state);
+}
 
-        /* clamps for tallies just in case */
-        if (st->tally_a > MAX_GOAL_A) st->tally_a = MAX_GOAL_A;
-        if (st->tally_b > MAX_GOAL_B) st->tally_b = MAX_GOAL_B;
+static void _goal_tracker_increment_tally(goal_tracker_state_t *state, bool for_b) {
+    uint16_t *tally = for_b ? &state->tally_b : &state->tally_a;
 
-        /* initialize transient fields */
-        st->hold_seconds_a = 0;
-        st->hold_seconds_b = 0;
-        st->action_done_during_hold_a = false;
-        st->action_done_during_hold_b = false;
+    if (*tally < (for_b ? MAX_GOAL_B : MAX_GOAL_A)) {
+        (*tally)++;
+        _goal_tracker_changed(state);
+    }
+    _goal_tracker_beep();
+}
 
-        st->ms_clock = 0;
-        st->last_tap_ms = 0;
-        st->tap_count = 0;
-        st->last_gesture_ms = 0;
+static void _goal_tracker_reset_tally(goal_tracker_state_t *state, bool for_b) {
+    if (for_b) state->tally_b = 0;
+    else state->tally_a = 0;
 
-        st->mode = MODE_NORMAL;
-        st->get_seconds_remaining = 0;
+    _goal_tracker_changed(state);
+    _goal_tracker_beep();
+}
 
-        *context_ptr = st;
+void goal_tracker_face_setup(uint8_t watch_face_index, void ** context_ptr) {
+    if (*context_ptr == NULL) {
+        *context_ptr = malloc(sizeof(goal_tracker_state_t));
+        goal_tracker_state_t *state = (goal_tracker_state_t *)*context_ptr;
+        memset(*context_ptr, 0, sizeof(goal_tracker_state_t));
+        state->watch_face_index = watch_face_index;
+        state->tallies_backup_register = movement_claim_backup_register();
+        state->goals_backup_register = movement_claim_backup_register();
+        _goal_tracker_load(state);
+        _goal_tracker_schedule_pace_alert(state);
     }
 }
 
-/* Activate: clear displays and ensure tick frequency */
-void goal_tracker_face_activate(movement_settings_t *settings, void *context) {
-    (void)context;
-    (void)settings;
-    watch_clear_display();
-    movement_request_tick_frequency(1); // 1 Hz updates (we rely on second resolution)
+void goal_tracker_face_activate(void *context) {
+    goal_tracker_state_t *state = (goal_tracker_state_t *)context;
+
+    state->top_dirty = true;
+    state->previous.reg = 0;
+    state->tap_count = 0;
+    _goal_tracker_keep_tap_detection(state);
 }
 
-/* Main event loop */
-bool goal_tracker_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
-    goal_tracker_face_state_t *st = (goal_tracker_face_state_t *)context;
-    if (!st) return false;
+bool goal_tracker_face_loop(movement_event_t event, void *context) {
+    goal_tracker_state_t *state = (goal_tracker_state_t *)context;
 
     switch (event.event_type) {
-
         case EVENT_ACTIVATE:
-            // reset hold & action flags; keep other state
-            st->hold_seconds_a = 0;
-            st->hold_seconds_b = 0;
-            st->action_done_during_hold_a = false;
-            st->action_done_during_hold_b = false;
-            // ms clock can continue; but we ensure it's initialized
-            if (st->ms_clock == 0) st->ms_clock = 0;
+            if (watch_sleep_animation_is_running()) watch_stop_sleep_animation();
+            // setup may have armed the pace timer before the clock was set after a reset, so check against today.
+            _goal_tracker_check_pace(state);
+            _goal_tracker_draw(state, false);
             break;
-
         case EVENT_TICK:
-            /* EVENT_TICK is delivered at 1Hz (we requested tick_frequency 1).
-               The movement framework may set event.subsecond to 0 at that time.
-               We'll use subsecond==0 as our 1-second marker. */
-            if (event.subsecond == 0) {
-                st->ms_clock += 1000; // advance ms clock by one second
-
-                /* ---------------------- Button hold handling ----------------------
-                   For each button we:
-                     - increment hold_seconds if the button is physically held (checked via movement_is_button_pressed)
-                     - when hold reaches INC threshold and no action done yet -> perform increment
-                     - when hold reaches RESET threshold and no action done yet -> perform reset (overrides inc)
-                     - when button released -> clear hold counter and action flag
-                -------------------------------------------------------------------*/
-
-                // LIGHT => Tally A
-                if (movement_is_button_pressed(BUTTON_LIGHT)) {
-                    st->hold_seconds_a++;
-                    if (!st->action_done_during_hold_a) {
-                        if (st->hold_seconds_a >= HOLD_INC_SECONDS && st->hold_seconds_a < HOLD_RESET_SECONDS) {
-                            // increment A (once)
-                            if (st->tally_a < MAX_GOAL_A) st->tally_a++;
-                            if (st->tally_a > MAX_GOAL_A) st->tally_a = MAX_GOAL_A;
-                            // persist lower 16-bit
-                            backup_write_u16(BK_TALLY_A_LO, BK_TALLY_A_HI, st->tally_a);
-                            st->action_done_during_hold_a = true;
-                        } else if (st->hold_seconds_a >= HOLD_RESET_SECONDS) {
-                            // reset A (overrides increment)
-                            st->tally_a = 0;
-                            backup_write_u16(BK_TALLY_A_LO, BK_TALLY_A_HI, st->tally_a);
-                            st->action_done_during_hold_a = true;
-                        }
-                    }
-                } else {
-                    // button released
-                    st->hold_seconds_a = 0;
-                    st->action_done_during_hold_a = false;
-                }
-
-                // ALARM => Tally B
-                if (movement_is_button_pressed(BUTTON_ALARM)) {
-                    st->hold_seconds_b++;
-                    if (!st->action_done_during_hold_b) {
-                        if (st->hold_seconds_b >= HOLD_INC_SECONDS && st->hold_seconds_b < HOLD_RESET_SECONDS) {
-                            // increment B (once)
-                            if (st->tally_b < MAX_GOAL_B) st->tally_b++;
-                            if (st->tally_b > MAX_GOAL_B) st->tally_b = MAX_GOAL_B;
-                            backup_write_u16(BK_TALLY_B_LO, BK_TALLY_B_HI, st->tally_b);
-                            st->action_done_during_hold_b = true;
-                        } else if (st->hold_seconds_b >= HOLD_RESET_SECONDS) {
-                            // reset B
-                            st->tally_b = 0;
-                            backup_write_u16(BK_TALLY_B_LO, BK_TALLY_B_HI, st->tally_b);
-                            st->action_done_during_hold_b = true;
-                        }
-                    }
-                } else {
-                    // released
-                    st->hold_seconds_b = 0;
-                    st->action_done_during_hold_b = false;
-                }
-
-                /* ---------------------- Accelerometer tap handling ----------------------
-                   Use LIS2DW's interrupt source register for reliable detection.
-                   lis2dw_get_int_source() returns the sensor's INT_SRC (tap) bits.
-
-                   Behavior:
-                     - if DOUBLE_TAP bit set -> immediate double-tap action (GET B)
-                     - if SINGLE_TAP bit set -> treat as a single tap and accumulate count
-                       to detect triple-tap (3 singles within TRIPLE_TAP_WINDOW_MS)
-                     - when a single-tap sequence times out without reaching 3, we confirm
-                       it as a single tap action (GET A)
-                     - we respect TAP_DEBOUNCE_MS after any confirmed gesture
-                ------------------------------------------------------------------------*/
-                uint8_t int_src = lis2dw_get_int_source();
-                uint32_t now = st->ms_clock;
-
-                // 1) double-tap (immediate)
-                if (int_src & LIS2DW_TAP_SRC_DOUBLE_TAP) {
-                    // debounce double-tap
-                    if (now - st->last_gesture_ms > TAP_DEBOUNCE_MS) {
-                        do_double_tap_action(st);     // GET B if behind
-                        st->last_gesture_ms = now;
-                        // reset any single-tap accumulation
-                        st->tap_count = 0;
-                        st->last_tap_ms = 0;
-                    }
-                }
-
-                // 2) single-tap reported by driver (accumulate for triple)
-                if (int_src & LIS2DW_TAP_SRC_SINGLE_TAP) {
-                    // ignore if in debounce period
-                    if (now - st->last_gesture_ms > TAP_DEBOUNCE_MS) {
-                        if (st->tap_count == 0) {
-                            st->tap_count = 1;
-                            st->last_tap_ms = now;
-                        } else {
-                            // if within triple window, add
-                            if (now - st->last_tap_ms <= TRIPLE_TAP_WINDOW_MS) {
-                                st->tap_count++;
-                                st->last_tap_ms = now;
-                            } else {
-                                // too late: reset sequence to start new
-                                st->tap_count = 1;
-                                st->last_tap_ms = now;
-                            }
-                        }
-
-                        // If we reached 3 single taps quickly => triple-tap
-                        if (st->tap_count >= 3) {
-                            // handle triple tap
-                            if (now - st->last_gesture_ms > TAP_DEBOUNCE_MS) {
-                                do_triple_tap_action(st);
-                                st->last_gesture_ms = now;
-                            }
-                            // reset tap accumulation
-                            st->tap_count = 0;
-                            st->last_tap_ms = 0;
-                        }
-                    } // end debounce check
-                }
-
-                // 3) if there is 1 or 2 single taps and the window expired -> confirm single tap
-                if (st->tap_count > 0) {
-                    if (now - st->last_tap_ms > TRIPLE_TAP_WINDOW_MS) {
-                        // window expired: interpret as single (we treat 2 quick singles as not double-
-                        // because driver gives double-tap bit when double detected; so this is only
-                        // 1-tap confirmation)
-                        if (now - st->last_gesture_ms > TAP_DEBOUNCE_MS) {
-                            // Confirm single tap
-                            do_single_tap_action(st);
-                            st->last_gesture_ms = now;
-                        }
-                        st->tap_count = 0;
-                        st->last_tap_ms = 0;
-                    }
-                } // end tap handling
-
-                // GET display countdown (on per-second tick)
-                if (st->mode == MODE_SHOW_GET) {
-                    if (st->get_seconds_remaining > 0) st->get_seconds_remaining--;
-                    if (st->get_seconds_remaining == 0) {
-                        st->mode = MODE_NORMAL;
-                    }
-                }
-            } // end subsecond==0 blocks
-
-            /* ---------------------- Rendering (every tick) ---------------------- */
-            if (st->mode == MODE_SHOW_GET) {
-                // priority: A then B (user requested this priority)
-                float def_a = compute_deficit(st->goal_a, st->tally_a);
-                float def_b = compute_deficit(st->goal_b, st->tally_b);
-
-                if (def_a > 0.0001f) {
-                    watch_display_string("GET A", TOP_DISPLAY_INDEX);
-                    char mbuf[12];
-                    // display with two decimals in a compact field; "%5.2f" yields e.g. " 2.62"
-                    snprintf(mbuf, sizeof(mbuf), "%5.2f", def_a);
-                    watch_display_string(mbuf, MAIN_DISPLAY_INDEX);
-                } else if (def_b > 0.0001f) {
-                    watch_display_string("GET B", TOP_DISPLAY_INDEX);
-                    char mbuf[12];
-                    snprintf(mbuf, sizeof(mbuf), "%5.2f", def_b);
-                    watch_display_string(mbuf, MAIN_DISPLAY_INDEX);
-                } else {
-                    // nothing behind anymore; revert to normal display
-                    char topbuf[16];
-                    render_top_line(st, topbuf, sizeof(topbuf));
-                    watch_display_string(topbuf, TOP_DISPLAY_INDEX);
-                    watch_display_time(settings->bit.clock_24h);
-                }
-            } else if (st->mode == MODE_SET_A) {
-                // Show SET A on top; main area shows current goal (integer)
-                watch_display_string("SET A", TOP_DISPLAY_INDEX);
-                char mbuf[12];
-                snprintf(mbuf, sizeof(mbuf), "%3u", (unsigned)st->goal_a);
-                watch_display_string(mbuf, MAIN_DISPLAY_INDEX);
-            } else if (st->mode == MODE_SET_B) {
-                // SET B mode
-                watch_display_string("SET B", TOP_DISPLAY_INDEX);
-                char mbuf[12];
-                snprintf(mbuf, sizeof(mbuf), "%2u", (unsigned)st->goal_b);
-                watch_display_string(mbuf, MAIN_DISPLAY_INDEX);
-            } else {
-                // Normal mode: top shows tallies, main shows time
-                char topbuf[16];
-                render_top_line(st, topbuf, sizeof(topbuf));
-                watch_display_string(topbuf, TOP_DISPLAY_INDEX);
-                watch_display_time(settings->bit.clock_24h);
+            _goal_tracker_check_tap_window(state);
+
+            if (state->get_seconds_remaining && --state->get_seconds_remaining == 0) {
+                _goal_tracker_set_mode(state, GOAL_TRACKER_MODE_NORMAL);
             }
 
-            break; // EVENT_TICK
+            if (state->tap_detection_ticks && --state->tap_detection_ticks == 0) {
+                movement_disable_tap_detection_if_available();
+            }
 
+            _goal_tracker_draw(state, false);
+            break;
+        case EVENT_LOW_ENERGY_UPDATE:
+            if (state->mode != GOAL_TRACKER_MODE_NORMAL) {
+                state->get_seconds_remaining = 0;
+                _goal_tracker_set_mode(state, GOAL_TRACKER_MODE_NORMAL);
+            }
+            _goal_tracker_abort_tap_detection(state);
+            _goal_tracker_draw(state, true);
+            if (!watch_sleep_animation_is_running()) watch_start_sleep_animation(1000);
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            // squelch the default LED; the light button is also the A button.
+            break;
         case EVENT_LIGHT_BUTTON_UP:
-            // In SET modes: LIGHT increments the current editing goal.
-            // In normal mode: LIGHT's long-hold was already handled in EVENT_TICK logic.
-            if (st->mode == MODE_SET_A) {
-                if (st->goal_a < MAX_GOAL_A) st->goal_a++;
-                if (st->goal_a < MIN_GOAL) st->goal_a = MIN_GOAL;
-                if (st->goal_a > MAX_GOAL_A) st->goal_a = MAX_GOAL_A;
-                backup_write_u16(BK_GOAL_A_LO, BK_GOAL_A_HI, st->goal_a);
-            } else if (st->mode == MODE_SET_B) {
-                if (st->goal_b < MAX_GOAL_B) st->goal_b++;
-                if (st->goal_b < MIN_GOAL) st->goal_b = MIN_GOAL;
-                if (st->goal_b > MAX_GOAL_B) st->goal_b = MAX_GOAL_B;
-                backup_write_u16(BK_GOAL_B_LO, BK_GOAL_B_HI, st->goal_b);
+            _goal_tracker_keep_tap_detection(state);
+            if (state->mode == GOAL_TRACKER_MODE_SET_A || state->mode == GOAL_TRACKER_MODE_SET_B) {
+                _goal_tracker_adjust_goal(state, 1);
+            } else {
+                movement_illuminate_led();
             }
+            _goal_tracker_draw(state, false);
             break;
-
         case EVENT_ALARM_BUTTON_UP:
-            // In SET modes: ALARM decrements the current editing goal.
-            if (st->mode == MODE_SET_A) {
-                if (st->goal_a > MIN_GOAL) st->goal_a--;
-                backup_write_u16(BK_GOAL_A_LO, BK_GOAL_A_HI, st->goal_a);
-            } else if (st->mode == MODE_SET_B) {
-                if (st->goal_b > MIN_GOAL) st->goal_b--;
-                backup_write_u16(BK_GOAL_B_LO, BK_GOAL_B_HI, st->goal_b);
+            _goal_tracker_keep_tap_detection(state);
+            if (state->mode == GOAL_TRACKER_MODE_SET_A || state->mode == GOAL_TRACKER_MODE_SET_B) {
+                _goal_tracker_adjust_goal(state, -1);
+            }
+            _goal_tracker_draw(state, false);
+            break;
+        case EVENT_LIGHT_LONG_PRESS:
+        case EVENT_ALARM_LONG_PRESS:
+            _goal_tracker_keep_tap_detection(state);
+            if (state->mode == GOAL_TRACKER_MODE_NORMAL) {
+                _goal_tracker_increment_tally(state, event.event_type == EVENT_ALARM_LONG_PRESS);
+                _goal_tracker_draw(state, false);
+            }
+            break;
+        case EVENT_LIGHT_REALLY_LONG_PRESS:
+        case EVENT_ALARM_REALLY_LONG_PRESS:
+            if (state->mode == GOAL_TRACKER_MODE_NORMAL) {
+                _goal_tracker_reset_tally(state, event.event_type == EVENT_ALARM_REALLY_LONG_PRESS);
+                _goal_tracker_draw(state, false);
             }
             break;
-
         case EVENT_MODE_BUTTON_UP:
-            // MODE is used to exit SET modes; in normal mode allow face to be changed (return false)
-            if (st->mode == MODE_SET_A || st->mode == MODE_SET_B) {
-                st->mode = MODE_NORMAL;
+            if (state->mode == GOAL_TRACKER_MODE_SET_A || state->mode == GOAL_TRACKER_MODE_SET_B) {
+                _goal_tracker_set_mode(state, GOAL_TRACKER_MODE_NORMAL);
+                _goal_tracker_draw(state, false);
             } else {
-                // allow leaving the face (consistent with other faces)
-                return false;
+                movement_move_to_next_face();
+            }
+            break;
+        case EVENT_SINGLE_TAP:
+            _goal_tracker_keep_tap_detection(state);
+            _goal_tracker_handle_single_tap(state);
+            _goal_tracker_draw(state, false);
+            break;
+        case EVENT_DOUBLE_TAP:
+            _goal_tracker_keep_tap_detection(state);
+            state->tap_count = 0;
+            if (state->mode == GOAL_TRACKER_MODE_NORMAL) _goal_tracker_show_get(state, GOAL_TRACKER_MODE_GET_B);
+            _goal_tracker_draw(state, false);
+            break;
+        case EVENT_TIMER_EXPIRED:
+            // we may not be in the foreground; the next tick or activation draws the GET, if any.
+            if (event.subsecond == PACE_TIMER_ID) _goal_tracker_check_pace(state);
+            break;
+        case EVENT_TIMEOUT:
+            // this face shows the time, so there's no need to resign; just leave SET mode.
+            if (state->mode == GOAL_TRACKER_MODE_SET_A || state->mode == GOAL_TRACKER_MODE_SET_B) {
+                _goal_tracker_set_mode(state, GOAL_TRACKER_MODE_NORMAL);
+                _goal_tracker_draw(state, false);
             }
             break;
-
         default:
+            movement_default_loop_handler(event);
             break;
-    } // end switch(event)
+    }
 
     return true;
 }
 
-/* Resign: called when leaving the face; nothing special to free (state persists) */
-void goal_tracker_face_resign(movement_settings_t *settings, void *context) {
-    (void)settings;
-    (void)context;
-}
+void goal_tracker_face_resign(void *context) {
+    goal_tracker_state_t *state = (goal_tracker_state_t *)context;
 
-/* ------------------------- End of file -------------------------
-   Notes / tuning tips for testing on your Sensor Watch Pro:
-
-   1) Tap interrupts:
-      - Make sure the board init code for Sensor Watch Pro enables LIS2DW tap interrupts.
-        Many Sensor Watch Pro board initializers call lis2dw_init() and configure tap detection.
-        If you find taps aren't detected, ensure LIS2DW is configured for single/double-tap
-        and that lis2dw_get_int_source() reflects that configuration.
-
-   2) TAP tuning:
-      - TRIPLE_TAP_WINDOW_MS (1500 ms) is reasonably generous: three quick taps within 1.5s.
-      - TAP_DEBOUNCE_MS (250 ms) prevents rapid re-triggering.
-      - You can adjust these constants at the top for your personal tapping style.
-
-   3) Backup storage:
-      - We used 2 bytes per 16-bit value so Tally A and Goal A can exceed 255.
-      - If you later want to expand or add extra variables, you have remaining backup bytes.
-
-   4) Display indices:
-      - TOP_DISPLAY_INDEX = 0, MAIN_DISPLAY_INDEX = 1 are the usual conventions for upgraded LCD.
-      - If your display is different, change those constants.
-
-   5) Goal editing:
-      - Triple-tap toggles between SET A and SET B (Option 3).
-      - While in SET A/B: use LIGHT to increment, ALARM to decrement, MODE to exit.
-      - Values are saved immediately into backup SRAM.
-
-   6) Increment/reset behavior:
-      - A hold of exactly 2s triggers increment (once). If you continue to hold to 5s,
-        the reset behavior triggers once and supersedes the increment (per your design).
-
-   7) Behavior after GET:
-      - A single tap shows GET A if A is behind; double tap shows GET B if B is behind.
-      - After showing GET, the face returns to normal; it does not automatically chain to the other tally.
-        (You can tap again to check the other.)
-
-   8) If you want I can:
-      - Provide a tiny board-init snippet to ensure lis2dw is configured for taps (if your board doesn't).
-      - Convert this code to a .c + .h pair.
-      - Add visual hold progress (flashing digit or small indicator while holding) for UX clarity.
-
-Enjoy — drop the file in, compile, and test taps/holds. If anything needs tuning (tap windows,
-debounce, or display index differences), tell me what you saw and I’ll produce a tuned iteration.
-------------------------------------------------------------------------- */
+    if (state->mode != GOAL_TRACKER_MODE_NORMAL) {
+        state->mode = GOAL_TRACKER_MODE_NORMAL;
+        state->get_seconds_remaining = 0;
+    }
+    _goal_tracker_abort_tap_detection(state);
+}
@@ -1,16 +1,83 @@
 #ifndef GOAL_TRACKER_FACE_H
 #define GOAL_TRACKER_FACE_H
 
+/*
+ * GOAL TRACKER face
+ *
+ * Tracks two monthly goals, A and B, against the day of the month. The top
+ * line shows tally A (top left) and tally B (top right); the main line shows
+ * the time.
+ *
+ * Light
+ *    Hold       : Add one to tally A
+ *    Really hold: Reset tally A (overrides the increment)
+ *    Press      : In SET mode, raise the goal. Otherwise, light.
+ *
+ * Alarm
+ *    Hold       : Add one to tally B
+ *    Really hold: Reset tally B (overrides the increment)
+ *    Press      : In SET mode, lower the goal.
+ *
+ * Mode
+ *    Press: In SET mode, return to the tallies. Otherwise, next face.
+ *
+ * Taps (on watches with an accelerometer, for 30 seconds after the last
+ * interaction):
+ *    Single tap: GET A, the number of units A is behind pace, if any
+ *    Double tap: GET B, the same for B
+ *    Triple tap: SET A, then SET B, to edit the goals
+ *
+ * Expected progress is goal * day / days in month. On a day when a tally
+ * falls another whole unit behind, the face buzzes and shows GET at 9 AM
+ * (GOAL_TRACKER_PACE_ALERT_HOUR), using one Movement timer computed in
+ * closed form. The buzz is skipped during Movement's quiet hours.
+ *
+ * Tallies and goals are kept in two backup registers. In low energy mode
+ * the main line shows hours and minutes only.
+ */
+
 #include "movement.h"
 
+typedef enum {
+    GOAL_TRACKER_MODE_NORMAL = 0,
+    GOAL_TRACKER_MODE_GET_A,
+    GOAL_TRACKER_MODE_GET_B,
+    GOAL_TRACKER_MODE_SET_A,
+    GOAL_TRACKER_MODE_SET_B,
+} goal_tracker_mode_t;
+
 typedef struct {
-    uint16_t goals_completed;
-    uint16_t goals_failed;
-    uint16_t current_streak;
-    uint16_t longest_streak;
-    uint32_t last_reset_timestamp;
+    uint16_t tally_a;
+    uint16_t tally_b;
+    uint16_t goal_a;
+    uint16_t goal_b;
+    // whole units behind pace at the last check
+    uint16_t pace_level_a;
+    uint16_t pace_level_b;
+    rtc_counter_t last_tap_counter;
+    // the time last drawn on the main line; 0 forces a full redraw
+    watch_date_time_t previous;
+    goal_tracker_mode_t mode;
+    uint8_t get_seconds_remaining;
+    uint8_t tap_count;
+    uint8_t tap_detection_ticks;
+    uint8_t tallies_backup_register;
+    uint8_t goals_backup_register;
+    uint8_t watch_face_index;
+    bool top_dirty;
 } goal_tracker_state_t;
 
-extern const watch_face_t goal_tracker_face;
+void goal_tracker_face_setup(uint8_t watch_face_index, void ** context_ptr);
+void goal_tracker_face_activate(void *context);
+bool goal_tracker_face_loop(movement_event_t event, void *context);
+void goal_tracker_face_resign(void *context);
+
+#define goal_tracker_face ((const watch_face_t){ \
+    goal_tracker_face_setup, \
+    goal_tracker_face_activate, \
+    goal_tracker_face_loop, \
+    goal_tracker_face_resign, \
+    NULL, \
+})
 
 #endif // GOAL_TRACKER_FACE_H
@@ -33,41 +33,48 @@
 #include "watch_common_display.h"
 
 #define DEFAULT_DICE_SIDES 2
-#define PROBABILITY_ANIMATION_TICK_FREQUENCY 8
+#define PROBABILITY_ANIMATION_FRAME_MS 125
 #define TAP_DETECTION_SECONDS 5
-#define ANIMATION_FRAMES 4
-#define SEGMENTS_PER_FRAME 2
 const uint16_t NUM_DICE_TYPES = 8; // Keep this consistent with # of dice types below
 const uint16_t DICE_TYPES[] = {2, 4, 6, 8, 10, 12, 20, 100};
 
-// Animation frame data: each frame defines which pixels to set
-// Each frame can have up to SEGMENTS_PER_FRAME pixels
-// Use {255, 255} to indicate end of pixel list for a frame
-typedef struct {
-    uint8_t com;
-    uint8_t seg;
-} com_seg_t;
-
-static const com_seg_t classic_lcd_animation_frames[ANIMATION_FRAMES][SEGMENTS_PER_FRAME] = {
-    // Frame 0: Second #1 F and C
-    {{1, 4}, {1, 6}},
-    // Frame 1: Second #1 A and D
-    {{2, 4}, {0, 6}},
-    // Frame 2: Second #1 B and E
-    {{2, 5}, {0, 5}},
-    // Frame 3: No pixels set (end animation)
-    {{255, 255}, {255, 255}}
+// Animation data: the pixels of the first seconds digit that the rolling animation spins through.
+// Each frame lights two of them: F and C, then A and D, then B and E, then none (end of the animation).
+static const movement_segment_t classic_lcd_animation_segments[] = {
+    {1, 4}, {1, 6}, // F, C
+    {2, 4}, {0, 6}, // A, D
+    {2, 5}, {0, 5}, // B, E
 };
 
-static const com_seg_t custom_lcd_animation_frames[ANIMATION_FRAMES][SEGMENTS_PER_FRAME] = {
-    // Frame 0: Second #1 F and C
-    {{2, 6}, {2, 7}},
-    // Frame 1: Second #1 A and D
-    {{3, 6}, {0, 7}},
-    // Frame 2: Second #1 B and E
-    {{3, 7}, {0, 6}},
-    // Frame 3: No pixels set (end animation)
-    {{255, 255}, {255, 255}}
+static const movement_segment_t custom_lcd_animation_segments[] = {
+    {2, 6}, {2, 7}, // F, C
+    {3, 6}, {0, 7}, // A, D
+    {3, 7}, {0, 6}, // B, E
+};
+
+static const uint32_t animation_frames[] = {
+    0b000011,
+    0b001100,
+    0b110000,
+    0b000000,
+};
+
+static const movement_animation_t classic_lcd_animation = {
+    .segments = classic_lcd_animation_segments,
+    .num_segments = sizeof(classic_lcd_animation_segments) / sizeof(movement_segment_t),
+    .frames = animation_frames,
+    .num_frames = sizeof(animation_frames) / sizeof(uint32_t),
+    .frame_duration_ms = PROBABILITY_ANIMATION_FRAME_MS,
+    .loop = false,
+};
+
+static const movement_animation_t custom_lcd_animation = {
+    .segments = custom_lcd_animation_segments,
+    .num_segments = sizeof(custom_lcd_animation_segments) / sizeof(movement_segment_t),
+    .frames = animation_frames,
+    .num_frames = sizeof(animation_frames) / sizeof(uint32_t),
+    .frame_duration_ms = PROBABILITY_ANIMATION_FRAME_MS,
+    .loop = false,
 };
 
 // --------------
@@ -152,57 +159,16 @@ static void roll_dice(probability_state_t *state)
 {
     generate_random_number(state);
     state->is_rolling = true;
-    // Dice rolling animation begins on next tick and new roll will be displayed on completion
-    movement_request_tick_frequency(PROBABILITY_ANIMATION_TICK_FREQUENCY);
-}
-
-static void display_dice_roll_animation(probability_state_t *state)
-{
-    if (state->is_rolling)
-    {
-        const com_seg_t (*animation_frames)[SEGMENTS_PER_FRAME] = classic_lcd_animation_frames;
-        if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-            animation_frames = custom_lcd_animation_frames;
-        }
 
-        // Clear main display areas on first frame
-        if (state->animation_frame == 0)
-        {
-            watch_display_text(WATCH_POSITION_HOURS, "  ");
-            watch_display_text(WATCH_POSITION_MINUTES, "  ");
-            watch_display_text(WATCH_POSITION_SECONDS, "  ");
-        }
+    // Clear main display areas, Movement plays the animation and we display the new roll when it's done
+    watch_display_text(WATCH_POSITION_HOURS, "  ");
+    watch_display_text(WATCH_POSITION_MINUTES, "  ");
+    watch_display_text(WATCH_POSITION_SECONDS, "  ");
 
-        // Clear pixels from previous frame (except on first frame)
-        if (state->animation_frame > 0)
-        {
-            const com_seg_t *prev_frame = animation_frames[state->animation_frame - 1];
-            for (int i = 0; i < SEGMENTS_PER_FRAME; i++)
-            {
-                if (prev_frame[i].com == 255) break; // End of pixel list
-                watch_clear_pixel(prev_frame[i].com, prev_frame[i].seg);
-            }
-        }
-
-        // Set pixels for current frame
-        const com_seg_t *current_frame = animation_frames[state->animation_frame];
-        for (int i = 0; i < SEGMENTS_PER_FRAME; i++)
-        {
-            if (current_frame[i].com == 255) break; // End of pixel list
-            watch_set_pixel(current_frame[i].com, current_frame[i].seg);
-        }
-
-        // Advance to next frame
-        state->animation_frame++;
-
-        // Check if animation is complete
-        if (state->animation_frame >= ANIMATION_FRAMES)
-        {
-            state->animation_frame = 0;
-            state->is_rolling = false;
-            movement_request_tick_frequency(1);
-            display_dice_roll(state);
-        }
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        movement_play_animation(&custom_lcd_animation);
+    } else {
+        movement_play_animation(&classic_lcd_animation);
     }
 }
 
@@ -246,7 +212,13 @@ bool probability_face_loop(movement_event_t event, void *context)
 {
     probability_state_t *state = (probability_state_t *)context;
 
-    if (state->is_rolling && event.event_type != EVENT_TICK)
+    if (state->is_rolling && event.event_type == EVENT_LOW_ENERGY_UPDATE)
+    {
+        // Movement stops animations when the watch goes to sleep, so the roll animation won't complete
+        state->is_rolling = false;
+    }
+
+    if (state->is_rolling && event.event_type != EVENT_ANIMATION_DONE && event.event_type != EVENT_TICK)
     {
         return true;
     }
@@ -256,9 +228,11 @@ bool probability_face_loop(movement_event_t event, void *context)
     case EVENT_ACTIVATE:
         display_dice_roll(state);
         break;
+    case EVENT_ANIMATION_DONE:
+        state->is_rolling = false;
+        display_dice_roll(state);
+        break;
     case EVENT_TICK:
-        display_dice_roll_animation(state);
-
         if (!state->is_rolling && state->tap_detection_ticks > 0) {
             state->tap_detection_ticks--;
             if (state->tap_detection_ticks == 0) {
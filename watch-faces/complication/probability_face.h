@@ -56,7 +56,6 @@
 typedef struct {
     uint8_t dice_sides;
     uint8_t rolled_value;
-    uint8_t animation_frame;
     bool is_rolling;
     uint8_t tap_detection_ticks;
 } probability_state_t;
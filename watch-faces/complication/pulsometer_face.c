@@ -32,6 +32,7 @@
 #include "pulsometer_face.h"
 #include "watch.h"
 #include "watch_common_display.h"
+#include "rate_estimator.h"
 
 #ifndef PULSOMETER_FACE_CALIBRATION_DEFAULT
 #define PULSOMETER_FACE_CALIBRATION_DEFAULT (30)
@@ -41,18 +42,24 @@
 #define PULSOMETER_FACE_CALIBRATION_INCREMENT (10)
 #endif
 
-// tick frequency will be 2 to this power Hz (0 for 1 Hz, 2 for 4 Hz, etc.)
-#ifndef PULSOMETER_FACE_FREQUENCY_FACTOR
-#define PULSOMETER_FACE_FREQUENCY_FACTOR (4ul)
+// taps further apart than this start a new measurement
+#ifndef PULSOMETER_FACE_TAP_TIMEOUT
+#define PULSOMETER_FACE_TAP_TIMEOUT (15)
 #endif
 
-#define PULSOMETER_FACE_FREQUENCY (1 << PULSOMETER_FACE_FREQUENCY_FACTOR)
+// seconds without a pulse before tap detection is turned off to spare the battery; ALARM turns it back on.
+#ifndef PULSOMETER_FACE_TAP_DETECTION_TIMEOUT
+#define PULSOMETER_FACE_TAP_DETECTION_TIMEOUT (30)
+#endif
 
 typedef struct {
-    bool measuring;
-    int16_t pulses;
-    int16_t ticks;
+    bool measuring;             // ALARM has been held long enough to be counting pulses
+    rtc_counter_t start;        // when ALARM went down
+    uint32_t rate;              // last result, in hundredths of pulses per minute
     int8_t calibration;
+    bool tap_detection;         // the accelerometer is listening for taps
+    rtc_counter_t last_pulse;   // when the last pulse was marked, or the face came up
+    rate_estimator_t taps;
 } pulsometer_state_t;
 
 static inline bool lcd_is_custom(void) {
@@ -76,20 +83,27 @@ static void pulsometer_display_calibration(pulsometer_state_t *pulsometer) {
 }
 
 static void pulsometer_display_measurement(pulsometer_state_t *pulsometer) {
-    if (lcd_is_custom()) {
-    char buf[5];
-    int16_t value = pulsometer->pulses;
+    uint32_t value = (pulsometer->rate + 50) / 100;
 
-    if (value < 0) value = 0;
-    if (value > 9999) value = 9999;
-
-    snprintf(buf, sizeof(buf), "%-4hd", value);
-    watch_display_text(WATCH_POSITION_BOTTOM, buf);
+    if (lcd_is_custom()) {
+        char buf[7];
+        if (pulsometer->rate && pulsometer->rate < 10000) {
+            // below 100 there is room for the hundredths
+            uint32_t rate = pulsometer->rate;
+            snprintf(buf, sizeof(buf), "%2lu%02lu  ", rate / 100, rate % 100);
+            watch_set_decimal_if_available();
+        } else {
+            if (value > 9999) value = 9999;
+            snprintf(buf, sizeof(buf), "%-6lu", value);
+            watch_clear_decimal_if_available();
+        }
+        watch_display_text(WATCH_POSITION_BOTTOM, buf);
     } else {
         char buf[7];
-        snprintf(buf, sizeof(buf), "%-6hd", pulsometer->pulses);
+        if (value > 999999) value = 999999;
+        snprintf(buf, sizeof(buf), "%-6lu", value);
         watch_display_text(WATCH_POSITION_BOTTOM, buf);
-    }  
+    }
 }
 
 static void pulsometer_indicate(pulsometer_state_t *pulsometer) {
@@ -102,36 +116,58 @@ static void pulsometer_indicate(pulsometer_state_t *pulsometer) {
 
 static void pulsometer_start_measurement(pulsometer_state_t *pulsometer) {
     pulsometer->measuring = true;
-    pulsometer->pulses = INT16_MAX;
-    pulsometer->ticks = 0;
 
     pulsometer_indicate(pulsometer);
-
-    movement_request_tick_frequency(PULSOMETER_FACE_FREQUENCY);
 }
 
+// While ALARM is held, show what the rate would be if it were let go now. The result comes from the button's
+// edge timestamps, so this only needs the 1 Hz tick.
 static void pulsometer_measure(pulsometer_state_t *pulsometer) {
     if (!pulsometer->measuring) { return; }
 
-    pulsometer->ticks++;
+    uint32_t ticks = watch_rtc_get_counter() - pulsometer->start;
+    pulsometer->rate = rate_estimator_rate_of(pulsometer->calibration, ticks, watch_rtc_get_frequency());
 
-    float ticks_per_minute = 60 << PULSOMETER_FACE_FREQUENCY_FACTOR;
-    float pulses_while_button_held = ticks_per_minute / pulsometer->ticks;
-    float calibrated_pulses = pulses_while_button_held * pulsometer->calibration;
-    calibrated_pulses += 0.5f;
+    pulsometer_display_measurement(pulsometer);
+}
 
-    pulsometer->pulses = (int16_t) calibrated_pulses;
+static void pulsometer_stop_measurement(pulsometer_state_t *pulsometer, rtc_counter_t stop) {
+    uint32_t ticks = stop - pulsometer->start;
+    pulsometer->rate = rate_estimator_rate_of(pulsometer->calibration, ticks, watch_rtc_get_frequency());
+    pulsometer->measuring = false;
+    rate_estimator_reset(&pulsometer->taps);
 
     pulsometer_display_measurement(pulsometer);
+    pulsometer_indicate(pulsometer);
 }
 
-static void pulsometer_stop_measurement(pulsometer_state_t *pulsometer) {
-    movement_request_tick_frequency(1);
+static void pulsometer_enable_tap_detection(pulsometer_state_t *pulsometer, rtc_counter_t counter) {
+    pulsometer->last_pulse = counter;
+    if (pulsometer->tap_detection) return;
+    pulsometer->tap_detection = movement_enable_tap_detection_if_available();
+}
 
-    pulsometer->measuring = false;
+static void pulsometer_disable_tap_detection(pulsometer_state_t *pulsometer) {
+    if (!pulsometer->tap_detection) return;
+    movement_disable_tap_detection_if_available();
+    pulsometer->tap_detection = false;
+}
+
+// A short press or a tap on the watch marks one pulse, at the counter captured in the button or accelerometer interrupt.
+static void pulsometer_tap(pulsometer_state_t *pulsometer, rtc_counter_t counter) {
+    pulsometer->last_pulse = counter;
+
+    if (pulsometer->taps.has_last && counter - pulsometer->taps.last > PULSOMETER_FACE_TAP_TIMEOUT * watch_rtc_get_frequency()) {
+        rate_estimator_reset(&pulsometer->taps);
+    }
+
+    rate_estimator_add(&pulsometer->taps, counter);
 
+    uint32_t rate = rate_estimator_get_rate(&pulsometer->taps, watch_rtc_get_frequency());
+    if (rate == 0) return;
+
+    pulsometer->rate = rate;
     pulsometer_display_measurement(pulsometer);
-    pulsometer_indicate(pulsometer);
 }
 
 static void pulsometer_cycle_calibration(pulsometer_state_t *pulsometer, int8_t increment) {
@@ -158,8 +194,8 @@ void pulsometer_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         pulsometer_state_t *pulsometer = malloc(sizeof(pulsometer_state_t));
 
         pulsometer->calibration = PULSOMETER_FACE_CALIBRATION_DEFAULT;
-        pulsometer->pulses = 0;
-        pulsometer->ticks = 0;
+        pulsometer->rate = 0;
+        rate_estimator_reset(&pulsometer->taps);
 
         *context_ptr = pulsometer;
     }
@@ -170,6 +206,9 @@ void pulsometer_face_activate(void *context) {
     pulsometer_state_t *pulsometer = context;
 
     pulsometer->measuring = false;
+    pulsometer->tap_detection = false;
+    rate_estimator_reset(&pulsometer->taps);
+    pulsometer_enable_tap_detection(pulsometer, watch_rtc_get_counter());
 
     pulsometer_display_title(pulsometer);
     pulsometer_display_calibration(pulsometer);
@@ -182,13 +221,26 @@ bool pulsometer_face_loop(movement_event_t event,void *context) {
 
     switch (event.event_type) {
         case EVENT_ALARM_BUTTON_DOWN:
+            pulsometer->start = movement_get_button_event_counter(event.event_type);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
             pulsometer_start_measurement(pulsometer);
             break;
         case EVENT_ALARM_BUTTON_UP:
+            pulsometer_enable_tap_detection(pulsometer, pulsometer->start);
+            pulsometer_tap(pulsometer, pulsometer->start);
+            break;
         case EVENT_ALARM_LONG_UP:
-            pulsometer_stop_measurement(pulsometer);
+            pulsometer_stop_measurement(pulsometer, movement_get_button_event_counter(event.event_type));
+            break;
+        case EVENT_SINGLE_TAP:
+            pulsometer_tap(pulsometer, movement_get_button_event_counter(event.event_type));
             break;
         case EVENT_TICK:
+            if (pulsometer->tap_detection &&
+                watch_rtc_get_counter() - pulsometer->last_pulse > PULSOMETER_FACE_TAP_DETECTION_TIMEOUT * watch_rtc_get_frequency()) {
+                pulsometer_disable_tap_detection(pulsometer);
+            }
             pulsometer_measure(pulsometer);
             break;
         case EVENT_LIGHT_BUTTON_UP:
@@ -212,5 +264,6 @@ bool pulsometer_face_loop(movement_event_t event,void *context) {
 }
 
 void pulsometer_face_resign(void *context) {
-    (void) context;
+    pulsometer_state_t *pulsometer = context;
+    pulsometer_disable_tap_detection(pulsometer);
 }
@@ -64,6 +64,15 @@
  * In order to measure breathing rate, simply hold the ALARM button
  * and count the number of breaths.
  *
+ * Alternatively, press ALARM briefly on every pulse, or tap the watch on
+ * watches with an accelerometer. The display shows the average rate over
+ * the last eight pulses, ignoring any that were missed or doubled.
+ * Tap detection turns itself off after 30 seconds without a pulse, to save
+ * the battery; press ALARM to turn it back on.
+ *
+ * Both methods time the pulses from the button edges and taps themselves,
+ * to 1/128 s. Rates below 100 are shown with hundredths on the custom LCD.
+ *
  * To calibrate the pulsometer, press LIGHT
  * to cycle to the next integer calibration.
  * Long press LIGHT to cycle it by 10.
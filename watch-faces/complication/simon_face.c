@@ -23,7 +23,6 @@
  */
 
 #include "simon_face.h"
-#include "delay.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,11 +32,12 @@
 #include <time.h>
 #endif
 
+#define SIMON_BUTTONS ((1UL << EVENT_LIGHT_BUTTON_UP) | (1UL << EVENT_MODE_BUTTON_UP) | (1UL << EVENT_ALARM_BUTTON_UP))
+
 static char _simon_display_buf[12];
-static uint8_t _timer;
 static uint16_t _delay_beep;
+static uint16_t _note_period;
 static uint16_t _timeout;
-static uint8_t _secSub;
 
 static inline uint8_t _simon_get_rand_num(uint8_t num_values) {
 #if __EMSCRIPTEN__
@@ -83,6 +83,8 @@ static void _simon_not_playing_display(simon_state_t *state) {
 }
 
 static void _simon_reset(simon_state_t *state) {
+    MOVEMENT_CO_RESET(&state->game);
+    watch_set_led_off();
     state->playing_state = SIMON_NOT_PLAYING;
     state->listen_index = 0;
     state->sequence_length = 0;
@@ -114,39 +116,33 @@ static void _simon_display_note(SimonNote note, simon_state_t *state) {
     }
 }
 
-static void _simon_play_note(SimonNote note, simon_state_t *state, bool skip_rest) {
+// Starts the light and sound of a note; the game waits out the note before calling _simon_end_note.
+static void _simon_start_note(SimonNote note, simon_state_t *state) {
     _simon_display_note(note, state);
     switch (note) {
         case SIMON_LED_NOTE:
             if (!state->lightOff) watch_set_led_yellow();
             if (!state->soundOff) watch_buzzer_play_note(BUZZER_NOTE_D3, _delay_beep);
-            delay_ms(_delay_beep);
             break;
         case SIMON_MODE_NOTE:
             if (!state->lightOff) watch_set_led_red();
             if (!state->soundOff) watch_buzzer_play_note(BUZZER_NOTE_E4, _delay_beep);
-            delay_ms(_delay_beep);
             break;
         case SIMON_ALARM_NOTE:
             if (!state->lightOff) watch_set_led_green();
             if (!state->soundOff) watch_buzzer_play_note(BUZZER_NOTE_C3, _delay_beep);
-            delay_ms(_delay_beep);
             break;
         case SIMON_WRONG_NOTE:
-            if (!state->soundOff) watch_buzzer_play_note(BUZZER_NOTE_A1, 800);
-            delay_ms(800);
+            // A1 is the end marker of a buzzer sequence, so it can't be played; use the next A up.
+            if (!state->soundOff) watch_buzzer_play_note(BUZZER_NOTE_A2, 800);
             break;
     }
-    watch_set_led_off();
-
-    if (note != SIMON_WRONG_NOTE) {
-        _simon_clear_display(state);
-        if (!skip_rest) {
-            delay_ms((_delay_beep * 2)/3);
-        }
-    }
 }
 
+static void _simon_end_note(simon_state_t *state) {
+    watch_set_led_off();
+    _simon_clear_display(state);
+}
 
 static void _simon_setup_next_note(simon_state_t *state) {
     if (state->sequence_length > state->best_score) {
@@ -161,24 +157,64 @@ static void _simon_setup_next_note(simon_state_t *state) {
     state->listen_index = 0;
 }
 
-static void _simon_listen(SimonNote note, simon_state_t *state) {
-    if (state->sequence[state->listen_index] == note) {
-        _simon_play_note(note, state, true);
-        state->listen_index++;
-        _timer = 0;
+static SimonNote _simon_note_for_event(movement_event_t event) {
+    switch (event.event_type) {
+        case EVENT_LIGHT_BUTTON_UP:
+            return SIMON_LED_NOTE;
+        case EVENT_MODE_BUTTON_UP:
+            return SIMON_MODE_NOTE;
+        default:
+            return SIMON_ALARM_NOTE;
+    }
+}
+
+// One game, from the first note to "OH NOOOOO". Runs as a coroutine, so the face stays at 1 Hz and the watch
+// sleeps between notes instead of ticking through them.
+static movement_coroutine_status_t _simon_game(simon_state_t *state, movement_event_t event) {
+    movement_coroutine_t *co = &state->game;
+    MOVEMENT_CO_BEGIN(co, event);
+
+    while (true) {
+        _simon_setup_next_note(state);
+        MOVEMENT_CO_AWAIT_MS(co, _note_period);
+
+        for (state->teaching_index = 0; state->teaching_index < state->sequence_length; state->teaching_index++) {
+            _simon_start_note(state->sequence[state->teaching_index], state);
+            MOVEMENT_CO_AWAIT_MS(co, _delay_beep);
+            _simon_end_note(state);
+            // if this is the final note in the sequence, don't rest, to let the player jump in faster
+            if (state->teaching_index < state->sequence_length - 1) {
+                MOVEMENT_CO_AWAIT_MS(co, _note_period - _delay_beep);
+            }
+        }
+
+        state->playing_state = SIMON_LISTENING_BACK;
+        for (state->listen_index = 0; state->listen_index < state->sequence_length; state->listen_index++) {
+            if (state->mode == SIMON_MODE_EASY) {
+                MOVEMENT_CO_AWAIT_BUTTON(co, SIMON_BUTTONS);
+                co->timed_out = false;
+            } else {
+                MOVEMENT_CO_AWAIT_BUTTON_OR_TICKS(co, SIMON_BUTTONS, movement_coroutine_ms_to_ticks(_timeout));
+            }
+            if (co->timed_out || _simon_note_for_event(co->event) != state->sequence[state->listen_index]) break;
 
-        if (state->listen_index == state->sequence_length) {
-            state->playing_state = SIMON_READY_FOR_NEXT_NOTE;
+            _simon_start_note(state->sequence[state->listen_index], state);
+            MOVEMENT_CO_AWAIT_MS(co, _delay_beep);
+            _simon_end_note(state);
         }
+
+        if (state->listen_index < state->sequence_length) break;
+        state->playing_state = SIMON_READY_FOR_NEXT_NOTE;
+    }
+
+    _simon_start_note(SIMON_WRONG_NOTE, state);
+    if (state->soundOff) {
+        MOVEMENT_CO_AWAIT_MS(co, 800);
     } else {
-        _simon_play_note(SIMON_WRONG_NOTE, state, true);
-        _simon_reset(state);
+        MOVEMENT_CO_AWAIT_BUZZER(co);
     }
-}
 
-static void _simon_begin_listening(simon_state_t *state) {
-    state->playing_state = SIMON_LISTENING_BACK;
-    state->listen_index = 0;
+    MOVEMENT_CO_END(co);
 }
 
 static void _simon_change_speed(simon_state_t *state){
@@ -186,13 +222,13 @@ static void _simon_change_speed(simon_state_t *state){
   {
   case SIMON_MODE_HARD:
         _delay_beep = DELAY_FOR_TONE_MS / 2;
-        _secSub = SIMON_FACE_FREQUENCY / 2;
-        _timeout = (TIMER_MAX * SIMON_FACE_FREQUENCY) / 2;
+        _note_period = NOTE_PERIOD_MS / 2;
+        _timeout = (TIMER_MAX * 1000) / 2;
     break;
   default:
         _delay_beep = DELAY_FOR_TONE_MS;
-        _secSub = SIMON_FACE_FREQUENCY;
-        _timeout = TIMER_MAX * SIMON_FACE_FREQUENCY;
+        _note_period = NOTE_PERIOD_MS;
+        _timeout = TIMER_MAX * 1000;
     break;
   }
 }
@@ -219,95 +255,60 @@ void simon_face_activate(void *context) {
   (void) context;
   simon_state_t *state = (simon_state_t *)context;
   _simon_change_speed(state);
-  movement_request_tick_frequency(SIMON_FACE_FREQUENCY);
-   _timer = 0;
 }
 
 bool simon_face_loop(movement_event_t event,
         void *context) {
     simon_state_t *state = (simon_state_t *)context;
 
+    if (state->playing_state != SIMON_NOT_PLAYING) {
+        switch (event.event_type) {
+            case EVENT_MODE_LONG_PRESS:
+                _simon_reset(state);
+                break;
+            case EVENT_TIMEOUT:
+                movement_move_to_face(0);
+                break;
+            default:
+                if (_simon_game(state, event) == MOVEMENT_COROUTINE_DONE) _simon_reset(state);
+                break;
+        }
+        return true;
+    }
+
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             // Show your initial UI here.
             _simon_reset(state);
             break;
-        case EVENT_TICK:
-            if (state->playing_state == SIMON_LISTENING_BACK && state->mode != SIMON_MODE_EASY)
-            {
-                _timer++;
-                if(_timer >= (_timeout)){
-                    _timer = 0;
-                    _simon_play_note(SIMON_WRONG_NOTE, state, true);
-                    _simon_reset(state);
-                }
-            }
-            else if (state->playing_state == SIMON_TEACHING && event.subsecond  == 0) {
-                SimonNote note = state->sequence[state->teaching_index];
-                // if this is the final note in the sequence, don't play the rest to let
-                // the player jump in faster
-                _simon_play_note(note, state, state->teaching_index == (state->sequence_length - 1));
-                state->teaching_index++;
-
-                if (state->teaching_index == state->sequence_length) {
-                    _simon_begin_listening(state);
-                }
-            }
-            else if (state->playing_state == SIMON_READY_FOR_NEXT_NOTE && (event.subsecond % _secSub)  == 0) {
-                _timer = 0;
-                _simon_setup_next_note(state);
-            }
-            break;
         case EVENT_LIGHT_BUTTON_DOWN:
             break;
         case EVENT_LIGHT_LONG_PRESS:
-            if (state->playing_state == SIMON_NOT_PLAYING) {
-                state->lightOff = !state->lightOff;
-                _simon_not_playing_display(state);
-            }
+            state->lightOff = !state->lightOff;
+            _simon_not_playing_display(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
-            if (state->playing_state == SIMON_NOT_PLAYING) {
-                state->soundOff = !state->soundOff;
-                _simon_not_playing_display(state);
-                if (!state->soundOff)
-                    watch_buzzer_play_note(BUZZER_NOTE_D3, _delay_beep);
-            }
+            state->soundOff = !state->soundOff;
+            _simon_not_playing_display(state);
+            if (!state->soundOff)
+                watch_buzzer_play_note(BUZZER_NOTE_D3, _delay_beep);
             break;
         case EVENT_LIGHT_BUTTON_UP:
-            if (state->playing_state == SIMON_NOT_PLAYING) {
-                state->sequence_length = 0;
-                watch_clear_indicator(WATCH_INDICATOR_BELL);
-                watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
-                _simon_setup_next_note(state);
-            } else if (state->playing_state == SIMON_LISTENING_BACK) {
-                _simon_listen(SIMON_LED_NOTE, state);
-            }
+            state->sequence_length = 0;
+            watch_clear_indicator(WATCH_INDICATOR_BELL);
+            watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
+            _simon_game(state, event);
             break;
         case EVENT_MODE_LONG_PRESS:
-            if (state->playing_state == SIMON_NOT_PLAYING) {
-                movement_move_to_face(0);
-            } else {
-                state->playing_state = SIMON_NOT_PLAYING;
-                _simon_reset(state);
-            }
+            movement_move_to_face(0);
             break;
         case EVENT_MODE_BUTTON_UP:
-            if (state->playing_state == SIMON_NOT_PLAYING) {
-                movement_move_to_next_face();
-            } else if (state->playing_state == SIMON_LISTENING_BACK) {
-                _simon_listen(SIMON_MODE_NOTE, state);
-            }
+            movement_move_to_next_face();
             break;
         case EVENT_ALARM_BUTTON_UP:
-            if (state->playing_state == SIMON_LISTENING_BACK) {
-                _simon_listen(SIMON_ALARM_NOTE, state);
-            }
-            else if (state->playing_state == SIMON_NOT_PLAYING){
-                state->mode = (state->mode + 1) % SIMON_MODE_TOTAL;
-                _simon_change_speed(state);
-                _simon_not_playing_display(state);
-            }
+            state->mode = (state->mode + 1) % SIMON_MODE_TOTAL;
+            _simon_change_speed(state);
+            _simon_not_playing_display(state);
             break;
         case EVENT_TIMEOUT:
             movement_move_to_face(0);
@@ -322,7 +323,9 @@ bool simon_face_loop(movement_event_t event,
 }
 
 void simon_face_resign(void *context) {
-    (void)context;
+    simon_state_t *state = (simon_state_t *)context;
+    // Movement has cancelled the game's wake-up; leaving mid-game ends it.
+    if (state->playing_state != SIMON_NOT_PLAYING) _simon_reset(state);
     watch_set_led_off();
     watch_set_buzzer_off();
 }
@@ -88,6 +88,7 @@ typedef struct {
     bool lightOff;
     uint8_t mode:6;
     SimonPlayingState playing_state;
+    movement_coroutine_t game;
 } simon_state_t;
 
 void simon_face_setup(uint8_t watch_face_index, void **context_ptr);
@@ -105,7 +106,7 @@ void simon_face_resign(void *context);
      })
 
 #define TIMER_MAX 5
-#define SIMON_FACE_FREQUENCY 8
+#define NOTE_PERIOD_MS 1000
 #define DELAY_FOR_TONE_MS 300
 
 #endif // SIMON_FACE_H_
@@ -63,7 +63,56 @@ static void _sunrise_sunset_set_expiration(sunrise_sunset_state_t *state, watch_
     state->rise_set_expires = watch_utility_date_time_from_unix_time(timestamp + 60, 0);
 }
 
-static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
+// One step of the rise/set job: works out the times for one day, computed_date first, then the day after.
+static bool _sunrise_sunset_job_step(void *context) {
+    sunrise_sunset_state_t *state = (sunrise_sunset_state_t *)context;
+    uint8_t day = state->days_computed;
+    watch_date_time_t date = state->computed_date;
+    if (day) date = watch_utility_date_time_from_unix_time(watch_utility_date_time_to_unix_time(date, 0) + 86400, 0);
+
+    // Weird quirky unsigned things were happening when I tried to cast these directly to doubles below.
+    // it looks redundant, but extracting them to local int16's seemed to fix it.
+    int16_t lat_centi = (int16_t)state->computed_location.bit.latitude;
+    int16_t lon_centi = (int16_t)state->computed_location.bit.longitude;
+
+    double lat = (double)lat_centi / 100.0;
+    double lon = (double)lon_centi / 100.0;
+
+    // all in software floating point, so let it run at full speed.
+    movement_begin_performance_burst();
+    state->result[day] = sun_rise_set(date.unit.year + WATCH_RTC_REFERENCE_YEAR, date.unit.month, date.unit.day, lon, lat, &state->rise[day], &state->set[day]);
+    movement_end_performance_burst();
+
+    state->days_computed = day + 1;
+    return state->days_computed == 2;
+}
+
+// Returns true if the rise/set times for today and tomorrow are ready. Otherwise it starts the job that works them
+// out, which comes back with EVENT_JOB_DONE; in low energy mode, where jobs don't run, it works them out itself.
+static bool _sunrise_sunset_times_ready(sunrise_sunset_state_t *state, movement_location_t location, watch_date_time_t date_time, bool wait) {
+    date_time.unit.hour = 0;
+    date_time.unit.minute = 0;
+    date_time.unit.second = 0;
+    if (date_time.reg != state->computed_date.reg || location.reg != state->computed_location.reg) {
+        state->computed_date = date_time;
+        state->computed_location = location;
+        state->days_computed = 0;
+        movement_job_cancel(state->face_idx, 0);
+    }
+    if (state->days_computed == 2) return true;
+
+    if (wait) {
+        movement_job_cancel(state->face_idx, 0);
+        while (!_sunrise_sunset_job_step(state));
+        return true;
+    }
+    if (!movement_job_is_queued(state->face_idx, 0)) {
+        movement_job_submit(state->face_idx, 0, _sunrise_sunset_job_step, state, 100);
+    }
+    return false;
+}
+
+static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state, bool wait) {
     char buf[14];
     double rise, set, minutes, seconds;
     bool show_next_match = false;
@@ -85,13 +134,8 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
     watch_date_time_t scratch_time; // scratchpad, contains different values at different times
     scratch_time.reg = date_time.reg;
 
-    // Weird quirky unsigned things were happening when I tried to cast these directly to doubles below.
-    // it looks redundant, but extracting them to local int16's seemed to fix it.
-    int16_t lat_centi = (int16_t)movement_location.bit.latitude;
-    int16_t lon_centi = (int16_t)movement_location.bit.longitude;
-
-    double lat = (double)lat_centi / 100.0;
-    double lon = (double)lon_centi / 100.0;
+    // keep showing what we had until the job is done.
+    if (!_sunrise_sunset_times_ready(state, movement_location, date_time, wait)) return;
 
     // sunriset returns the rise/set times as signed decimal hours in UTC.
     // this can mean hours below 0 or above 31, which won't fit into a watch_date_time_t struct.
@@ -100,7 +144,9 @@ static void _sunrise_sunset_face_update(sunrise_sunset_state_t *state) {
 
     // we loop twice because if it's after sunset today, we need to recalculate to display values for tomorrow.
     for(int i = 0; i < 2; i++) {
-        uint8_t result = sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &rise, &set);
+        uint8_t result = state->result[i];
+        rise = state->rise[i];
+        set = state->set[i];
 
         if (result != 0) {
             watch_clear_colon();
@@ -451,11 +497,11 @@ static void _sunrise_sunset_face_advance_digit(sunrise_sunset_state_t *state) {
 }
 
 void sunrise_sunset_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(sunrise_sunset_state_t));
         memset(*context_ptr, 0, sizeof(sunrise_sunset_state_t));
     }
+    ((sunrise_sunset_state_t *)*context_ptr)->face_idx = watch_face_index;
 }
 
 void sunrise_sunset_face_activate(void *context) {
@@ -487,7 +533,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            _sunrise_sunset_face_update(state);
+            _sunrise_sunset_face_update(state, false);
             break;
         case EVENT_LOW_ENERGY_UPDATE:
         case EVENT_TICK:
@@ -499,7 +545,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 if (date_time.reg >= state->rise_set_expires.reg) {
                     // and on the off chance that this happened before EVENT_TIMEOUT snapped us back to rise/set 0, go back now
                     state->rise_index = 0;
-                    _sunrise_sunset_face_update(state);
+                    _sunrise_sunset_face_update(state, event.event_type == EVENT_LOW_ENERGY_UPDATE);
                 }
             } else {
                 _sunrise_sunset_face_update_settings_display(event, state);
@@ -529,7 +575,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
             }
             if (state->page == 0) {
                 movement_request_tick_frequency(1);
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
             }
             break;
         case EVENT_LIGHT_LONG_PRESS:
@@ -539,7 +585,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
         case EVENT_LIGHT_BUTTON_UP:
             if (state->page == 0 && _location_count > 1) {
                 state->longLatToUse = (state->longLatToUse + 1) % _location_count;
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
             }
             break;
         case EVENT_ALARM_BUTTON_UP:
@@ -548,14 +594,14 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 _sunrise_sunset_face_update_settings_display(event, context);
             } else {
                 state->rise_index = (state->rise_index + 1) % 2;
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
             }
             break;
         case EVENT_ALARM_LONG_PRESS:
             if (state->page == 0) {
             if (state->longLatToUse != 0) {
                 state->longLatToUse = 0;
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
                 break;
             }
                 state->page++;
@@ -568,9 +614,12 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 state->active_digit = 0;
                 state->page = 0;
                 _sunrise_sunset_face_update_location_register(state);
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
             }
             break;
+        case EVENT_JOB_DONE:
+            if (state->page == 0) _sunrise_sunset_face_update(state, false);
+            break;
         case EVENT_TIMEOUT:
             if (load_location_from_filesystem().reg == 0) {
                 // if no location set, return home
@@ -580,7 +629,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 state->page = 0;
                 state->rise_index = 0;
                 movement_request_tick_frequency(1);
-                _sunrise_sunset_face_update(state);
+                _sunrise_sunset_face_update(state, false);
             }
             break;
         default:
@@ -592,6 +641,8 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
 
 void sunrise_sunset_face_resign(void *context) {
     sunrise_sunset_state_t *state = (sunrise_sunset_state_t *)context;
+    // a job still running would only have come back to draw over the next face.
+    movement_job_cancel(state->face_idx, 0);
     state->page = 0;
     state->active_digit = 0;
     state->rise_index = 0;
@@ -56,6 +56,14 @@ typedef struct {
     sunrise_sunset_lat_lon_settings_t working_latitude;
     sunrise_sunset_lat_lon_settings_t working_longitude;
     uint8_t longLatToUse;
+    uint8_t face_idx;
+    // rise and set times in UTC hours for computed_date and the day after, worked out by a Movement job.
+    watch_date_time_t computed_date;
+    movement_location_t computed_location;
+    uint8_t days_computed;
+    uint8_t result[2];
+    double rise[2];
+    double set[2];
 } sunrise_sunset_state_t;
 
 void sunrise_sunset_face_setup(uint8_t watch_face_index, void ** context_ptr);
@@ -135,7 +135,9 @@ static void totp_display_code(totp_state_t *totp_state) {
 
     result = div(totp_state->timestamp, totp->period);
     if (result.quot != totp_state->steps) {
+        movement_begin_performance_burst();
         totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
+        movement_end_performance_burst();
         totp_state->steps = result.quot;
     }
     valid_for = totp->period - result.rem;
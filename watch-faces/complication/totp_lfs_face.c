@@ -236,7 +236,9 @@ static void totp_face_set_record(totp_lfs_state_t *totp_state, int i) {
         record->period,
         record->algorithm
     );
+    movement_begin_performance_burst();
     totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
+    movement_end_performance_burst();
     totp_state->steps = totp_state->timestamp / record->period;
 }
 
@@ -267,7 +269,9 @@ static void totp_face_display(totp_lfs_state_t *totp_state) {
 
     div_t result = div(totp_state->timestamp, totp_records[index].period);
     if (result.quot != totp_state->steps) {
+        movement_begin_performance_burst();
         totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
+        movement_end_performance_burst();
         totp_state->steps = result.quot;
     }
     uint8_t valid_for = totp_records[index].period - result.rem;
@@ -29,10 +29,63 @@
 #include "watch.h"
 #include "watch_utility.h"
 
+static uint32_t _activity_logging_face_day_number(watch_date_time_t date_time) {
+    // day numbers count local days, so treat the local time as if it were UTC.
+    return daily_history_day_number(watch_utility_date_time_to_unix_time(date_time, 0));
+}
+
+static void _activity_logging_face_display_stats(activity_logging_state_t *state, uint8_t stat) {
+    static const char *labels[ACTIVITY_LOGGING_NUM_STATS] = { "WK ", "MO ", "YR ", "WA ", "MA ", "YA ", "ST ", "BS " };
+    char buf[8];
+    watch_date_time_t today = movement_get_local_date_time();
+    uint32_t today_number = _activity_logging_face_day_number(today);
+    uint32_t first_day;
+
+    // totals and averages cover the week, month or year so far; the streaks are over the whole log.
+    if (stat >= 6) {
+        first_day = state->history.first_day;
+    } else if (stat % 3 == 0) {
+        first_day = today_number - 6;
+    } else if (stat % 3 == 1) {
+        first_day = today_number - (today.unit.day - 1);
+    } else {
+        today.unit.month = 1;
+        today.unit.day = 1;
+        first_day = _activity_logging_face_day_number(today);
+    }
+
+    // the log holds complete days only; today's minutes so far come from our state.
+    daily_history_stats_t stats;
+    daily_history_get_stats(&state->history, first_day, today_number - 1, &stats);
+    uint32_t total = stats.total + state->active_minutes_today;
+    uint32_t num_days = stats.num_days + 1;
+    uint16_t streak = stats.streak;
+    if (state->active_minutes_today >= ACTIVITY_LOGGING_STREAK_MINUTES) streak++;
+    uint16_t best_streak = streak > stats.best_streak ? streak : stats.best_streak;
+
+    watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
+    watch_display_text(WATCH_POSITION_TOP_LEFT, labels[stat]);
+    watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
+
+    if (stat < 3) {
+        snprintf(buf, 8, "%6lu", (unsigned long)total);
+    } else if (stat < 6) {
+        snprintf(buf, 8, "%6lu", (unsigned long)((total + num_days / 2) / num_days));
+    } else {
+        snprintf(buf, 8, "%6u", stat == 6 ? streak : best_streak);
+    }
+    watch_display_text(WATCH_POSITION_BOTTOM, buf);
+}
+
 static void _activity_logging_face_update_display(activity_logging_state_t *state) {
     char buf[8];
     watch_date_time_t timestamp = movement_get_local_date_time();
 
+    if (state->display_index >= ACTIVITY_LOGGING_NUM_DAYS) {
+        _activity_logging_face_display_stats(state, state->display_index - ACTIVITY_LOGGING_NUM_DAYS);
+        return;
+    }
+
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "ACT", "AC");
 
     if (state->display_index == 0) {
@@ -73,6 +126,8 @@ void activity_logging_face_setup(uint8_t watch_face_index, void ** context_ptr)
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(activity_logging_state_t));
         memset(*context_ptr, 0, sizeof(activity_logging_state_t));
+        activity_logging_state_t *state = (activity_logging_state_t *)*context_ptr;
+        daily_history_open(&state->history, "activity.hst", ACTIVITY_LOGGING_STREAK_MINUTES);
         // At first run, tell Movement to run the accelerometer in the background. It will now run at this rate forever.
         movement_set_accelerometer_background_rate(LIS2DW_DATA_RATE_LOWEST);
     }
@@ -90,11 +145,11 @@ bool activity_logging_face_loop(movement_event_t event, void *context) {
             movement_illuminate_led();
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
-            state->display_index = (state->display_index + ACTIVITY_LOGGING_NUM_DAYS - 1) % ACTIVITY_LOGGING_NUM_DAYS;
+            state->display_index = (state->display_index + ACTIVITY_LOGGING_NUM_SCREENS - 1) % ACTIVITY_LOGGING_NUM_SCREENS;
             _activity_logging_face_update_display(state);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
-            state->display_index = (state->display_index + 1) % ACTIVITY_LOGGING_NUM_DAYS;
+            state->display_index = (state->display_index + 1) % ACTIVITY_LOGGING_NUM_SCREENS;
             // fall through
         case EVENT_ACTIVATE:
             if (watch_sleep_animation_is_running()) {
@@ -114,6 +169,9 @@ bool activity_logging_face_loop(movement_event_t event, void *context) {
                 size_t pos = state->data_points % ACTIVITY_LOGGING_NUM_DAYS;
                 state->activity_log[pos] = state->active_minutes_today;
                 state->data_points++;
+                // we run at midnight, so the minutes we've been counting belong to yesterday.
+                uint32_t yesterday = _activity_logging_face_day_number(movement_get_local_date_time()) - 1;
+                daily_history_append(&state->history, yesterday, state->active_minutes_today);
                 state->active_minutes_today = 0;
             }
             break;
@@ -40,6 +40,12 @@
  *
  * A short press of the Alarm button moves backwards in the data log, showing yesterday's active minutes,
  * then the day before, etc. going back 14 days.
+ * Past the 14th day, Alarm moves on to statistics, kept in a daily history on the filesystem. Today's
+ * minutes so far are included in each of them:
+ *  - WK, MO, YR: total active minutes over the last 7 days, this month and this year.
+ *  - WA, MA, YA: the average active minutes per day over the same periods.
+ *  - ST: the current streak of days with at least 30 active minutes.
+ *  - BS: the best streak so far.
  * A short press of the Light button moves forward in the data log, looping around if we're on the most-recent day.
  * Holding the Light button will illuminate the display.
  *
@@ -47,8 +53,12 @@
 
 #include "movement.h"
 #include "watch.h"
+#include "daily_history.h"
 
 #define ACTIVITY_LOGGING_NUM_DAYS (14)
+#define ACTIVITY_LOGGING_NUM_STATS (8)
+#define ACTIVITY_LOGGING_NUM_SCREENS (ACTIVITY_LOGGING_NUM_DAYS + ACTIVITY_LOGGING_NUM_STATS)
+#define ACTIVITY_LOGGING_STREAK_MINUTES (30)
 
 typedef struct {
     uint16_t activity_log[ACTIVITY_LOGGING_NUM_DAYS];   // the activity log
@@ -56,6 +66,7 @@ typedef struct {
     uint8_t display_index;                              // the index we are displaying on screen
     uint16_t active_minutes_today;                      // the number of active minutes logged today
     bool previous_minute_was_active;                    // we only want to count two or more consecutive active minutes
+    daily_history_t history;                            // every day's active minutes, for the statistics screens
 } activity_logging_state_t;
 
 void activity_logging_face_setup(uint8_t watch_face_index, void ** context_ptr);
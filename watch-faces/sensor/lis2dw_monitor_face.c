@@ -115,6 +115,12 @@ static void _settings_data_rate_display(void *context, uint8_t subsecond)
         case LIS2DW_DATA_RATE_25_HZ:
             snprintf(buf, sizeof(buf), "  25Hz");
             break;
+        case LIS2DW_DATA_RATE_50_HZ:
+            snprintf(buf, sizeof(buf), "  50Hz");
+            break;
+        case LIS2DW_DATA_RATE_100_HZ:
+            snprintf(buf, sizeof(buf), " 100Hz");
+            break;
         default:
             snprintf(buf, sizeof(buf), "  HI  ");
             break;
@@ -137,6 +143,12 @@ static void _settings_data_rate_advance(void *context)
             state->ds.data_rate = LIS2DW_DATA_RATE_25_HZ;
             break;
         case LIS2DW_DATA_RATE_25_HZ:
+            state->ds.data_rate = LIS2DW_DATA_RATE_50_HZ;
+            break;
+        case LIS2DW_DATA_RATE_50_HZ:
+            state->ds.data_rate = LIS2DW_DATA_RATE_100_HZ;
+            break;
+        case LIS2DW_DATA_RATE_100_HZ:
             state->ds.data_rate = LIS2DW_DATA_RATE_POWERDOWN;
             break;
         default:
@@ -383,10 +395,71 @@ static void _lis2dw_set_state(lis2dw_device_state_t *ds)
     movement_set_accelerometer_background_rate(ds->data_rate);
 }
 
+/* Sampling rate in millihertz, or 0 if samples do not arrive at a fixed rate. */
+static uint32_t _lis2dw_sample_rate(lis2dw_device_state_t *ds)
+{
+    if (ds->mode == LIS2DW_MODE_ON_DEMAND)
+        return 0;
+
+    switch (ds->data_rate) {
+        case LIS2DW_DATA_RATE_LOWEST:
+            return (ds->mode == LIS2DW_MODE_LOW_POWER) ? 1600 : 12500;
+        case LIS2DW_DATA_RATE_12_5_HZ:
+            return 12500;
+        case LIS2DW_DATA_RATE_25_HZ:
+            return 25000;
+        case LIS2DW_DATA_RATE_50_HZ:
+            return 50000;
+        case LIS2DW_DATA_RATE_100_HZ:
+            return 100000;
+        case LIS2DW_DATA_RATE_200_HZ:
+            return 200000;
+        default:
+            return 0;
+    }
+}
+
+/* Convert a raw amplitude to mg; readings are left-aligned 16-bit values. */
+static uint32_t _lis2dw_amplitude_mg(lis2dw_device_state_t *ds, uint16_t amplitude)
+{
+    static const uint16_t micro_g_per_lsb[] = { 61, 122, 244, 488 };
+    return ((uint32_t) amplitude * micro_g_per_lsb[ds->range] + 500) / 1000;
+}
+
+static void _spectrum_display(lis2dw_monitor_state_t *state)
+{
+    char buf[10];
+
+    snprintf(buf, sizeof(buf), "F%C", "XYZ"[state->axis]);
+    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, buf, buf);
+
+    if (!state->has_peak || _lis2dw_sample_rate(&state->ds) == 0) {
+        watch_clear_decimal_if_available();
+        watch_display_text_with_fallback(WATCH_POSITION_TOP_RIGHT, "  ", "  ");
+        watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "  --  ", "  --  ");
+        return;
+    }
+
+    uint32_t mg = _lis2dw_amplitude_mg(&state->ds, state->peak.amplitude);
+    snprintf(buf, sizeof(buf), "%2lu", (mg > 99) ? 99 : mg);
+    watch_display_text_with_fallback(WATCH_POSITION_TOP_RIGHT, buf, buf);
+
+    uint32_t centihertz = (state->peak.frequency_mhz + 5) / 10;
+    snprintf(buf, sizeof(buf), "%2lu%02luHz", centihertz / 100, centihertz % 100);
+    watch_set_decimal_if_available();
+    watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf);
+}
+
 static void _monitor_display(lis2dw_monitor_state_t *state)
 {
     char buf[10];
 
+    if (state->show_spectrum && !state->show_title) {
+        _spectrum_display(state);
+        return;
+    }
+    watch_clear_decimal_if_available();
+
     snprintf(buf, sizeof(buf), " %C ", "XYZ"[state->axis]);
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, buf, buf);
 
@@ -440,12 +513,55 @@ static void _monitor_update(lis2dw_monitor_state_t *state)
     lis2dw_clear_fifo();
 }
 
+static void _spectrum_update(lis2dw_monitor_state_t *state)
+{
+    lis2dw_fifo_t fifo;
+    int16_t samples[SPECTRUM_SIZE];
+    uint32_t rate = _lis2dw_sample_rate(&state->ds);
+
+    /* Only analyze full blocks; the FIFO stops collecting once it has 32. */
+    if (rate == 0 || lis2dw_get_fifo_count() < SPECTRUM_SIZE) {
+        return;
+    }
+
+    rtc_counter_t start = watch_rtc_get_counter();
+    /* A read that times out leaves fewer readings than a full block; don't analyze those. */
+    fifo.count = 0;
+    lis2dw_read_fifo(&fifo, LIS2DW_FIFO_TIMEOUT / DISPLAY_FREQUENCY);
+    lis2dw_clear_fifo();
+    if (fifo.count < SPECTRUM_SIZE) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SPECTRUM_SIZE; i++) {
+        if (state->axis == 0) {
+            samples[i] = fifo.readings[i].x;
+        } else if (state->axis == 1) {
+            samples[i] = fifo.readings[i].y;
+        } else {
+            samples[i] = fifo.readings[i].z;
+        }
+    }
+
+    state->has_peak = spectrum_find_peak(samples, rate, &state->peak);
+    if (!state->has_peak) {
+        return;
+    }
+
+    /* Elapsed time covers the bus transfer, too; it should stay below 32 / rate. */
+    uint32_t elapsed_ms = (watch_rtc_get_counter() - start) * 1000 / 128;
+    WATCH_LOG_INFO("FFT %c: %lu mHz, %lu mg", "XYZ"[state->axis], state->peak.frequency_mhz,
+                   _lis2dw_amplitude_mg(&state->ds, state->peak.amplitude));
+    WATCH_LOG_DEBUG("FFT bin %u, %lu ms", state->peak.bin, elapsed_ms);
+}
+
 static void _switch_to_monitor(lis2dw_monitor_state_t *state)
 {
     /* Switch to recording page */
     movement_request_tick_frequency(DISPLAY_FREQUENCY);
     state->page = PAGE_LIS2DW_MONITOR;
     state->show_title = DISPLAY_FREQUENCY;
+    state->has_peak = false;
     _monitor_display(state);
 }
 
@@ -469,18 +585,32 @@ static bool _monitor_loop(movement_event_t event, void *context)
             _monitor_display(state);
             break;
         case EVENT_TICK:
-            _monitor_update(state);
+            if (state->show_spectrum) {
+                _spectrum_update(state);
+            } else {
+                _monitor_update(state);
+            }
             _monitor_display(state);
             state->show_title = (state->show_title > 0) ? state->show_title - 1 : 0;
             break;
         case EVENT_ALARM_BUTTON_UP:
             state->axis = (state->axis + 1) % 3;
+            state->has_peak = false;
             _monitor_display(state);
             break;
+        case EVENT_ALARM_LONG_PRESS:
+            /* Start the spectrum from a fresh block. */
+            state->show_spectrum = !state->show_spectrum;
+            state->has_peak = false;
+            lis2dw_clear_fifo();
+            _monitor_display(state);
+            _beep();
+            break;
         case EVENT_LIGHT_BUTTON_DOWN:
             /* Do nothing. */
             break;
         case EVENT_LIGHT_LONG_PRESS:
+            watch_clear_decimal_if_available();
             _switch_to_settings(state);
             _beep();
             break;
@@ -600,6 +730,7 @@ bool lis2dw_monitor_face_loop(movement_event_t event, void *context)
 void lis2dw_monitor_face_resign(void *context)
 {
     (void) context;
+    watch_clear_decimal_if_available();
     lis2dw_clear_fifo();
     lis2dw_disable_fifo();
 }
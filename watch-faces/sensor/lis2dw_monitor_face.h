@@ -26,6 +26,14 @@
  * This watch face displays the current reading of the LIS2DW12 accelerometer.
  * The axis (x,y,z) can be selected using the alarm button. 
  * 
+ * A long press on the alarm button toggles the spectrum view. Each time the
+ * sensor's FIFO fills up with 32 samples, the selected axis goes through a
+ * fixed-point FFT, and the face shows the dominant vibration frequency in Hz
+ * on the main line and its amplitude in mg (capped at 99) in the top right.
+ * Both are also printed to the console. Frequencies up to half the data rate
+ * can be told apart, in steps of 1/32 of it before interpolation, so use
+ * 25 Hz or more for tremor and 100 Hz for machinery.
+ * 
  * A long press on the light button allows to configure the sensor, including 
  * its mode, data rate, low power mode, bandwidth filtering, range, filter type,
  * and low noise mode.
@@ -35,6 +43,7 @@
  */
 
 #include "movement.h"
+#include "spectrum.h"
 
 typedef enum {
     PAGE_LIS2DW_MONITOR,
@@ -64,6 +73,9 @@ typedef struct {
     uint8_t settings_page:3;    /* Subpage in settings */
     lis2dw_settings_t *settings;        /* Settings config */
     uint8_t show_title:6;       /* Display face title */
+    bool show_spectrum;         /* Show dominant frequency instead of reading */
+    bool has_peak;              /* Peak below is valid */
+    spectrum_peak_t peak;       /* Dominant frequency of last FIFO block */
 } lis2dw_monitor_state_t;
 
 void lis2dw_monitor_face_setup(uint8_t watch_face_index, void **context_ptr);
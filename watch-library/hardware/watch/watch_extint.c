@@ -22,12 +22,15 @@
  * SOFTWARE.
  */
 
-#include <stdio.h>
 #include "watch_extint.h"
+#include "watch_log.h"
 #include "watch_gpio.h"
+#include "watch_rtc.h"
 #include "eic.h"
+#include "tc.h"
 
 watch_cb_t eic_callbacks[16] = { NULL };
+static uint8_t eic_pins[16] = { 0 };
 
 void watch_eic_callback(uint8_t channel);
 
@@ -54,14 +57,187 @@ void watch_register_interrupt_callback(const uint8_t pin, watch_cb_t callback, e
 
     int8_t channel = eic_configure_pin(pin, trigger, filten);
     if (channel >= 0 && channel < 16) {
-        printf("Configured port %d pin %d on channel %d\n", pin >> 5, pin & 0x1F, channel);
+        WATCH_LOG_DEBUG("Configured port %d pin %d on channel %d", pin >> 5, pin & 0x1F, channel);
         eic_enable_interrupt(pin);
         eic_callbacks[channel] = callback;
+        eic_pins[channel] = pin;
     }
 }
 
+static int8_t _watch_eic_channel(const uint8_t pin) {
+    for (int8_t channel = 0; channel < 16; channel++) {
+        if (eic_callbacks[channel] != NULL && eic_pins[channel] == pin) return channel;
+    }
+    return -1;
+}
+
+void watch_mask_interrupt(const uint8_t pin) {
+    int8_t channel = _watch_eic_channel(pin);
+    if (channel < 0) return;
+
+    EIC->INTENCLR.reg = 1 << channel;
+}
+
+void watch_unmask_interrupt(const uint8_t pin) {
+    int8_t channel = _watch_eic_channel(pin);
+    if (channel < 0) return;
+
+    // the flag still gets set while the interrupt is masked; clear it, or we'd take the stale edge right away.
+    EIC->INTFLAG.reg = 1 << channel;
+    EIC->INTENSET.reg = 1 << channel;
+}
+
 void watch_eic_callback(uint8_t channel) {
     if (eic_callbacks[channel] != NULL) {
         eic_callbacks[channel]();
     }
 }
+
+// Edge capture. Each captured pin's EIC channel drives event channel n, whose user is the capture input of
+// _capture_tcs[n]. The timers are 16 bits wide; their overflow interrupts count the upper 16 bits, and
+// _capture_offset takes the result to the RTC's epoch. They start on the same clock edge, so one offset fits all.
+static Tc * const _capture_tcs[WATCH_CAPTURE_MAX_PINS] = { TC2, TC3 };
+static const uint8_t _capture_tc_instances[WATCH_CAPTURE_MAX_PINS] = { 2, 3 };
+static const IRQn_Type _capture_irqs[WATCH_CAPTURE_MAX_PINS] = { TC2_IRQn, TC3_IRQn };
+static const uint8_t _capture_evsys_users[WATCH_CAPTURE_MAX_PINS] = { EVSYS_ID_USER_TC2_EVU, EVSYS_ID_USER_TC3_EVU };
+static uint8_t _capture_pins[WATCH_CAPTURE_MAX_PINS];
+static uint8_t _capture_count = 0;
+static volatile uint16_t _capture_overflows[WATCH_CAPTURE_MAX_PINS];
+static uint32_t _capture_offset;
+
+void irq_handler_tc2(void);
+void irq_handler_tc3(void);
+
+void irq_handler_tc2(void) {
+    TC2->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+    _capture_overflows[0]++;
+}
+
+void irq_handler_tc3(void) {
+    TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+    _capture_overflows[1]++;
+}
+
+static int8_t _watch_capture_slot(const uint8_t pin) {
+    for (uint8_t slot = 0; slot < _capture_count; slot++) {
+        if (_capture_pins[slot] == pin) return slot;
+    }
+    return -1;
+}
+
+// The EIC interrupt for an edge is pending from the moment of the capture, and it outranks the timers', so an
+// overflow after a capture can't have been counted before the capture is read. An overflow before it might not be.
+static uint32_t _watch_capture_extend(uint8_t slot, uint16_t count) {
+    uint16_t overflows = _capture_overflows[slot];
+    if ((_capture_tcs[slot]->COUNT16.INTFLAG.reg & TC_INTFLAG_OVF) && count < 0x8000) overflows++;
+    return (((uint32_t)overflows << 16) | count) + _capture_offset;
+}
+
+// Reading the count waits for it to cross from the 1024 Hz clock domain, which takes a few milliseconds; this is
+// only for edges that weren't captured.
+static uint32_t _watch_capture_read_counter(uint8_t slot) {
+    Tc *tc = _capture_tcs[slot];
+    tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (tc->COUNT16.SYNCBUSY.bit.CTRLB);
+    while (tc->COUNT16.CTRLBSET.bit.CMD);
+    return _watch_capture_extend(slot, tc->COUNT16.COUNT.reg);
+}
+
+void watch_discard_capture(const uint8_t pin) {
+    int8_t slot = _watch_capture_slot(pin);
+    if (slot < 0) return;
+
+    // reading CC0 moves the buffered capture, if any, into it.
+    Tc *tc = _capture_tcs[slot];
+    while (tc->COUNT16.INTFLAG.bit.MC0) (void)tc->COUNT16.CC[0].reg;
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_ERR;
+}
+
+uint32_t watch_get_capture(const uint8_t pin) {
+    int8_t slot = _watch_capture_slot(pin);
+    if (slot < 0) {
+        // not captured: fall back to the RTC, scaled to the same units.
+        return watch_rtc_get_counter() * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency());
+    }
+
+    Tc *tc = _capture_tcs[slot];
+    uint32_t timestamp;
+    if (tc->COUNT16.INTFLAG.bit.MC0) {
+        timestamp = _watch_capture_extend(slot, tc->COUNT16.CC[0].reg);
+    } else {
+        timestamp = _watch_capture_read_counter(slot);
+    }
+    watch_discard_capture(pin);
+
+    return timestamp;
+}
+
+void watch_disable_capture(void) {
+    for (uint8_t slot = 0; slot < _capture_count; slot++) {
+        int8_t channel = _watch_eic_channel(_capture_pins[slot]);
+        if (channel >= 0) {
+            // EVCTRL is enable-protected.
+            eic_disable();
+            EIC->EVCTRL.reg &= ~EIC_EVCTRL_EXTINTEO(1 << channel);
+            eic_enable();
+        }
+        EVSYS->USER[_capture_evsys_users[slot]].reg = 0;
+        EVSYS->CHANNEL[slot].reg = 0;
+        NVIC_DisableIRQ(_capture_irqs[slot]);
+        tc_disable(_capture_tc_instances[slot]);
+    }
+    _capture_count = 0;
+}
+
+bool watch_enable_capture(const uint8_t pins[], const uint8_t count) {
+    watch_disable_capture();
+    if (count > WATCH_CAPTURE_MAX_PINS) return false;
+
+    int8_t channels[WATCH_CAPTURE_MAX_PINS];
+    for (uint8_t slot = 0; slot < count; slot++) {
+        channels[slot] = _watch_eic_channel(pins[slot]);
+        if (channels[slot] < 0) return false;
+    }
+
+    MCLK->APBCMASK.reg |= MCLK_APBCMASK_EVSYS;
+    uint32_t event_outputs = 0;
+    for (uint8_t slot = 0; slot < count; slot++) {
+        Tc *tc = _capture_tcs[slot];
+        uint8_t instance = _capture_tc_instances[slot];
+
+        // one count per cycle of the 1024 Hz clock, through standby.
+        tc_init(instance, GENERIC_CLOCK_3, TC_PRESCALER_DIV1);
+        tc_set_counter_mode(instance, TC_COUNTER_MODE_16BIT);
+        tc_set_run_in_standby(instance, true);
+        tc->COUNT16.CTRLA.bit.CAPTEN0 = 1;
+        tc->COUNT16.EVCTRL.reg = TC_EVCTRL_TCEI | TC_EVCTRL_EVACT_OFF;
+        tc->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+        _capture_overflows[slot] = 0;
+        NVIC_ClearPendingIRQ(_capture_irqs[slot]);
+        NVIC_EnableIRQ(_capture_irqs[slot]);
+
+        // asynchronous, so the edge gets to the timer without a clock, in standby too.
+        EVSYS->CHANNEL[slot].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_EIC_EXTINT_0 + channels[slot]) |
+                                   EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+        EVSYS->USER[_capture_evsys_users[slot]].reg = EVSYS_USER_CHANNEL(slot + 1);
+        event_outputs |= 1 << channels[slot];
+        _capture_pins[slot] = pins[slot];
+    }
+
+    eic_disable();
+    EIC->EVCTRL.reg |= EIC_EVCTRL_EXTINTEO(event_outputs);
+    eic_enable();
+
+    // write all the enables before waiting on any of them, or each would start one synchronization after the last.
+    for (uint8_t slot = 0; slot < count; slot++) _capture_tcs[slot]->COUNT16.CTRLA.bit.ENABLE = 1;
+    for (uint8_t slot = 0; slot < count; slot++) while (_capture_tcs[slot]->COUNT16.SYNCBUSY.bit.ENABLE);
+    _capture_count = count;
+
+    // line the count up with the RTC: wait for a fresh RTC tick, then read the count as close to it as we can.
+    _capture_offset = 0;
+    rtc_counter_t counter = watch_rtc_get_counter();
+    while (watch_rtc_get_counter() == counter);
+    _capture_offset = (counter + 1) * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency()) - _watch_capture_read_counter(0);
+
+    return true;
+}
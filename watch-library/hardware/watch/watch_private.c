@@ -29,9 +29,20 @@
 #include "usb.h"
 #include "system.h"
 
+static uint32_t _watch_cpu_frequency;
+
+static void _watch_set_cpu_frequency(uint32_t frequency) {
+    set_cpu_frequency(frequency);
+    _watch_cpu_frequency = frequency;
+}
+
+uint32_t _watch_get_cpu_frequency(void) {
+    return _watch_cpu_frequency;
+}
+
 void _watch_init(void) {
     // set frequency to 4 MHz
-    set_cpu_frequency(4000000);
+    _watch_set_cpu_frequency(4000000);
 
     // disable debugger hot-plugging
     HAL_GPIO_SWCLK_pmuxdis();
@@ -133,11 +144,48 @@ int getentropy(void *buf, size_t buflen) {
 
 
 void _watch_enable_usb(void) {
-    set_cpu_frequency(8000000);
+    _watch_set_cpu_frequency(8000000);
     usb_init();
     usb_enable();
 }
 
+void watch_set_cpu_high_performance(bool high_performance) {
+    // Calls are expected to alternate; Movement's performance bursts take care of that.
+    static uint8_t low_power_wait_states;
+    static bool have_low_power_wait_states = false;
+
+    if (high_performance) {
+        // the regulator has to reach PL2 before the clock may go above what PL0 allows,
+        PM->INTFLAG.reg = PM_INTFLAG_PLRDY;
+        PM->PLCFG.bit.PLSEL = PM_PLCFG_PLSEL_PL2_Val;
+        while (!PM->INTFLAG.bit.PLRDY);
+        // and the flash needs a wait state at 16 MHz. Only note the low power setting the first time: a burst
+        // that ends while USB is enabled leaves the wait state in place, and that's not the one to go back to.
+        if (!have_low_power_wait_states) {
+            low_power_wait_states = NVMCTRL->CTRLB.bit.RWS;
+            have_low_power_wait_states = true;
+        }
+        NVMCTRL->CTRLB.bit.RWS = 1;
+        _watch_set_cpu_frequency(16000000);
+        // a buzzer or LED already running would otherwise play four times too fast.
+        _watch_update_tcc_prescaler();
+    } else {
+        // on the way down, in the reverse order.
+        if (usb_is_enabled()) {
+            // USB runs on external power, so there's no reason to drop the regulator back to PL0.
+            _watch_set_cpu_frequency(8000000);
+            _watch_update_tcc_prescaler();
+            return;
+        }
+        _watch_set_cpu_frequency(4000000);
+        _watch_update_tcc_prescaler();
+        NVMCTRL->CTRLB.bit.RWS = low_power_wait_states;
+        PM->INTFLAG.reg = PM_INTFLAG_PLRDY;
+        PM->PLCFG.bit.PLSEL = PM_PLCFG_PLSEL_PL0_Val;
+        while (!PM->INTFLAG.bit.PLRDY);
+    }
+}
+
 void watch_reset_to_bootloader(void) {
     volatile uint32_t *dbl_tap_ptr = ((volatile uint32_t *)(HSRAM_ADDR + HSRAM_SIZE - 4));
     *dbl_tap_ptr = 0xf01669ef; // from the UF2 bootloaer: uf2.h line 255
@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "watch_profiler.h"
+#include "tc.h"
+
+#if WATCH_PROFILER_SLOTS & (WATCH_PROFILER_SLOTS - 1)
+#error "WATCH_PROFILER_SLOTS must be a power of two"
+#endif
+
+typedef struct {
+    uint32_t pc[WATCH_PROFILER_SLOTS];      // 0 marks a free slot; code never runs from address 0
+    uint16_t count[WATCH_PROFILER_SLOTS];
+} watch_profiler_table_t;
+
+static watch_profiler_table_t *_profiler_table = NULL;
+static volatile uint32_t _profiler_samples;
+static volatile uint32_t _profiler_dropped;
+static bool _profiler_running = false;
+
+void irq_handler_tc1(void);
+void _watch_profiler_sample(uint32_t pc);
+
+// The interrupted PC is in the exception frame the CPU stacked on entry, so this has to run before the compiler
+// pushes anything of its own. It finds the frame and tail-calls the C handler with the PC, leaving LR alone so
+// that the C handler's return is the exception return.
+__attribute__((naked)) void irq_handler_tc1(void) {
+    __asm volatile(
+        "movs r0, #4\n"
+        "mov r1, lr\n"
+        "tst r0, r1\n"
+        "bne 1f\n"
+        "mrs r0, msp\n"
+        "b 2f\n"
+        "1: mrs r0, psp\n"
+        "2: ldr r0, [r0, #24]\n"
+        "ldr r1, 3f\n"
+        "bx r1\n"
+        ".align 2\n"
+        "3: .word _watch_profiler_sample\n"
+    );
+}
+
+__attribute__((used)) void _watch_profiler_sample(uint32_t pc) {
+    TC1->COUNT8.INTFLAG.reg = TC_INTFLAG_OVF;
+    _profiler_samples++;
+
+    // Fibonacci hashing; instructions are halfword aligned, so the low bit carries nothing.
+    uint32_t slot = ((pc >> 1) * 2654435761u) >> (32 - __builtin_ctz(WATCH_PROFILER_SLOTS));
+    for (uint8_t i = 0; i < WATCH_PROFILER_MAX_PROBES; i++) {
+        uint32_t *slot_pc = &_profiler_table->pc[slot];
+        if (*slot_pc == pc || *slot_pc == 0) {
+            *slot_pc = pc;
+            if (_profiler_table->count[slot] != UINT16_MAX) _profiler_table->count[slot]++;
+            return;
+        }
+        slot = (slot + 1) & (WATCH_PROFILER_SLOTS - 1);
+    }
+    _profiler_dropped++;
+}
+
+bool watch_profiler_start(void) {
+    if (_profiler_running) return true;
+
+    if (_profiler_table == NULL) {
+        _profiler_table = calloc(1, sizeof(watch_profiler_table_t));
+        if (_profiler_table == NULL) return false;
+        _profiler_samples = 0;
+        _profiler_dropped = 0;
+    }
+
+    // 1024 cycles per count, 16 counts per overflow. No RUNSTDBY: there are no cycles to count in standby.
+    tc_init(1, GENERIC_CLOCK_0, TC_PRESCALER_DIV1024);
+    tc_set_counter_mode(1, TC_COUNTER_MODE_8BIT);
+    tc_count8_set_period(1, (WATCH_PROFILER_PERIOD_CYCLES / 1024) - 1);
+    TC1->COUNT8.INTENSET.bit.OVF = 1;
+    NVIC_ClearPendingIRQ(TC1_IRQn);
+    NVIC_EnableIRQ(TC1_IRQn);
+    tc_enable(1);
+    _profiler_running = true;
+
+    return true;
+}
+
+void watch_profiler_stop(void) {
+    if (!_profiler_running) return;
+
+    tc_disable(1);
+    NVIC_DisableIRQ(TC1_IRQn);
+    _profiler_running = false;
+}
+
+bool watch_profiler_is_running(void) {
+    return _profiler_running;
+}
+
+void watch_profiler_free(void) {
+    watch_profiler_stop();
+    free(_profiler_table);
+    _profiler_table = NULL;
+    _profiler_samples = 0;
+    _profiler_dropped = 0;
+}
+
+bool watch_profiler_read(uint16_t *position, uint32_t *pc, uint16_t *count) {
+    if (_profiler_table == NULL) return false;
+
+    while (*position < WATCH_PROFILER_SLOTS) {
+        uint16_t slot = (*position)++;
+        if (_profiler_table->pc[slot]) {
+            *pc = _profiler_table->pc[slot];
+            *count = _profiler_table->count[slot];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t watch_profiler_get_samples(void) {
+    return _profiler_samples;
+}
+
+uint32_t watch_profiler_get_dropped(void) {
+    return _profiler_dropped;
+}
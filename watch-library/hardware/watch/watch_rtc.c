@@ -42,7 +42,7 @@ static const uint32_t RTC_COMP_GRACE_PERIOD = 4;
 
 static const int TB_BKUP_REG = 7;
 
-#define WATCH_RTC_N_COMP_CB 8
+#define WATCH_RTC_N_COMP_CB 16
 
 typedef struct {
     volatile uint32_t counter;
@@ -141,6 +141,11 @@ uint32_t watch_rtc_get_frequency(void) {
     return RTC_CNT_HZ;
 }
 
+uint32_t watch_rtc_get_missed_periodic_callbacks(void) {
+    // a periodic interrupt that comes due while another is pending just sets the same flag again.
+    return 0;
+}
+
 uint32_t watch_rtc_get_ticks_per_minute(void) {
     return RTC_CNT_TICKS_PER_MINUTE;
 }
@@ -272,6 +272,13 @@ inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
     slcd_clear_segment(com, seg);
 }
 
+bool watch_get_pixel(uint8_t com, uint8_t seg) {
+    // SDATALn holds segments 0-31 of common n and SDATAHn the rest; the two registers alternate in memory.
+    /// TODO: Wrap this in a gossamer call.
+    volatile uint32_t *sdata = &SLCD->SDATAL0.reg;
+    return (sdata[com * 2 + seg / 32] >> (seg % 32)) & 1;
+}
+
 void watch_clear_display(void) {
     slcd_clear();
 }
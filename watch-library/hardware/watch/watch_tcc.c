@@ -23,6 +23,7 @@
  */
 
 #include "watch_tcc.h"
+#include "watch_private.h"
 #include "delay.h"
 #include "tcc.h"
 #include "tc.h"
@@ -230,7 +231,7 @@ void watch_buzzer_abort_sequence(void) {
 }
 
 void watch_buzzer_register_global_callbacks(watch_cb_t cb_start, watch_cb_t cb_stop) {
-    _cb_stop_global = cb_start;
+    _cb_start_global = cb_start;
     _cb_stop_global = cb_stop;
 }
 
@@ -316,13 +317,18 @@ void watch_buzzer_play_note_with_volume(watch_buzzer_note_t note, uint16_t durat
 }
 
 void _watch_enable_tcc(void) {
-    // set up the TCC with a 1 MHz clock, but there's a trick:
-    if (USB->DEVICE.CTRLA.bit.ENABLE) {
-        // if USB is enabled, we are running an 8 MHz clock, so we divide by 8.
-        tcc_init(0, GENERIC_CLOCK_0, TCC_PRESCALER_DIV8);
-    } else {
-        // otherwise it's 4 Mhz and we divide by 4.
-        tcc_init(0, GENERIC_CLOCK_0, TCC_PRESCALER_DIV4);
+    // set up the TCC with a 1 MHz clock, but there's a trick: the main clock runs at 4 MHz, at 8 MHz while USB is
+    // enabled, and at 16 MHz during a performance burst, so the prescaler has to match.
+    switch (_watch_get_cpu_frequency()) {
+        case 16000000:
+            tcc_init(0, GENERIC_CLOCK_0, TCC_PRESCALER_DIV16);
+            break;
+        case 8000000:
+            tcc_init(0, GENERIC_CLOCK_0, TCC_PRESCALER_DIV8);
+            break;
+        default:
+            tcc_init(0, GENERIC_CLOCK_0, TCC_PRESCALER_DIV4);
+            break;
     }
     // We're going to use normal PWM mode, which means period is controlled by PER, and duty cycle is controlled by
     // each compare channel's value:
@@ -357,6 +363,31 @@ void _watch_enable_tcc(void) {
     tcc_enable(0);
 }
 
+void _watch_update_tcc_prescaler(void) {
+    if (!tcc_is_enabled(0)) return;
+
+    uint8_t prescaler;
+    switch (_watch_get_cpu_frequency()) {
+        case 16000000:
+            prescaler = TCC_CTRLA_PRESCALER_DIV16_Val;
+            break;
+        case 8000000:
+            prescaler = TCC_CTRLA_PRESCALER_DIV8_Val;
+            break;
+        default:
+            prescaler = TCC_CTRLA_PRESCALER_DIV4_Val;
+            break;
+    }
+
+    // the prescaler is enable-protected; PER and CC keep their values while the TCC is off, and since it still
+    // counts at 1 MHz, tones and LED colors carry on as they were.
+    TCC0->CTRLA.bit.ENABLE = 0;
+    while (TCC0->SYNCBUSY.bit.ENABLE);
+    TCC0->CTRLA.bit.PRESCALER = prescaler;
+    TCC0->CTRLA.bit.ENABLE = 1;
+    while (TCC0->SYNCBUSY.bit.ENABLE);
+}
+
 void _watch_disable_tcc(void) {
     // disable all PWM pins
     HAL_GPIO_BUZZER_pmuxdis();
@@ -111,28 +111,37 @@ static void prv_handle_reads(void) {
 }
 
 static void prv_handle_writes(void) {
-    if (s_write_buf_len > 0) {
-        const size_t start_pos =
-            CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
-        for (size_t i = 0; i < (size_t) s_write_buf_len; i++) {
-            const size_t idx = CDC_WRITE_BUF_IDX(start_pos + i);
-            if (tud_cdc_available() > 0) {
-                // If we receive data while doing a large write, we need to
-                // fully service it before continuing to write, or the
-                // stack will crash.
-                prv_handle_reads();
-            }
-            if (tud_cdc_write_available()) {
-                tud_cdc_write(&s_write_buf[idx], 1);
-            }
-            s_write_buf[idx] = 0;
-            s_write_buf_len--;
+    if (!tud_cdc_connected()) {
+        // Nobody has the port open, so there's no one to wait for.
+        s_write_buf_len = 0;
+        return;
+    }
+
+    while (s_write_buf_len > 0) {
+        if (tud_cdc_available() > 0) {
+            // If we receive data while doing a large write, we need to
+            // fully service it before continuing to write, or the
+            // stack will crash.
+            prv_handle_reads();
+        }
+        if (!tud_cdc_write_available()) {
+            // The rest goes out on a later pass, once the host has taken
+            // what is already queued.
+            break;
         }
-        tud_cdc_write_flush();
+        const size_t idx = CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
+        tud_cdc_write(&s_write_buf[idx], 1);
+        s_write_buf[idx] = 0;
+        s_write_buf_len--;
     }
+    tud_cdc_write_flush();
 }
 
 void cdc_task(void) {
     prv_handle_reads();
     prv_handle_writes();
 }
+
+bool cdc_is_idle(void) {
+    return s_write_buf_len == 0 && s_read_buf_len == 0 && tud_cdc_available() == 0;
+}
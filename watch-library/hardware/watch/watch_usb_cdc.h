@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 int _write(int file, char *ptr, int len);
 int _read(int file, char *ptr, int len);
 void cdc_task(void);
+bool cdc_is_idle(void);
@@ -277,6 +277,15 @@ inline void lis2dw_disable_fifo(void) {
 #endif
 }
 
+uint8_t lis2dw_get_fifo_count(void) {
+    // unlike lis2dw_read_fifo, this leaves the samples in the FIFO.
+#ifdef I2C_SERCOM
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE) & LIS2DW_FIFO_SAMPLE_COUNT;
+#else
+    return 0;
+#endif
+}
+
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout) {
     // timeout is in terms of 1/RTC_CNT_HZ seconds (likely 128 timeouts is one second)
 #ifdef I2C_SERCOM
@@ -288,6 +297,8 @@ bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout) {
     rtc_counter_t timeout_counter = watch_rtc_get_counter() + timeout;
     for(int i = 0; i < fifo_data->count; i++) {
         if (watch_rtc_get_counter() > timeout_counter) {
+            // only count the readings we actually got.
+            fifo_data->count = i;
             break;
         }
         fifo_data->readings[i] = lis2dw_get_raw_reading();
@@ -295,7 +306,7 @@ bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data, uint32_t timeout) {
 
     return overrun;
 #else
-    (void) fifo_data;
+    fifo_data->count = 0;
     (void) timeout;
     return false;
 #endif
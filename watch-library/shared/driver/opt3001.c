@@ -89,3 +89,26 @@ opt3001_t opt3001_readRegister(uint8_t devaddr, opt3001_Command_t command) {
     result.lux = 0.01*pow(2, er.Exponent)*er.Result;
     return result;
 }
+
+uint32_t opt3001_toCentilux(opt3001_ER_t raw) {
+	return (uint32_t)raw.Result << raw.Exponent;
+}
+
+opt3001_ER_t opt3001_fromCentilux(uint32_t centilux) {
+	opt3001_ER_t er;
+	uint8_t exponent = 0;
+	// the largest exponent is 11; anything above 4095 << 11 saturates.
+	while (centilux > 0x0FFF && exponent < 11) {
+		centilux >>= 1;
+		exponent++;
+	}
+	if (centilux > 0x0FFF) centilux = 0x0FFF;
+	er.Result = centilux;
+	er.Exponent = exponent;
+	return er;
+}
+
+void opt3001_writeLimit(uint8_t devaddr, opt3001_Command_t command, opt3001_ER_t limit) {
+	uint8_t buf[3] = {(uint8_t) command, (uint8_t)(limit.rawData >> 8), (uint8_t)(limit.rawData & 0x00FF)};
+	watch_i2c_send(devaddr, buf, 3);
+}
@@ -42,6 +42,9 @@ typedef enum {
 	OPT3001_DEVICE_ID		= 0x7F,
 } opt3001_Command_t;
 
+#define OPT3001_MANUFACTURER_ID_TI 0x5449
+#define OPT3001_DEVICE_ID_OPT3001 0x3001
+
 typedef union {
 	uint16_t rawData;
 	struct {
@@ -84,4 +87,9 @@ opt3001_Config_t opt3001_readConfig(uint8_t devaddr);
 void opt3001_writeConfig(uint8_t devaddr, opt3001_Config_t config);
 opt3001_t opt3001_readRegister(uint8_t devaddr, opt3001_Command_t command);
 
+// Integer conversions, for code that shouldn't pull in floating point: one centilux is the sensor's smallest step.
+uint32_t opt3001_toCentilux(opt3001_ER_t raw);
+opt3001_ER_t opt3001_fromCentilux(uint32_t centilux);
+void opt3001_writeLimit(uint8_t devaddr, opt3001_Command_t command, opt3001_ER_t limit);
+
 #endif // OPT3001_
@@ -72,6 +72,8 @@ typedef void (*watch_cb_t)(void);
 #include "watch_uart.h"
 #include "watch_storage.h"
 #include "watch_deepsleep.h"
+#include "watch_log.h"
+#include "watch_profiler.h"
 
 /** @brief Interrupt handler for the SYSTEM interrupt, which handles MCLK,
  *         OSC32KCTRL, OSCCTRL, PAC, PM and SUPC.
@@ -85,6 +87,15 @@ void irq_handler_system(void);
   */
 void watch_reset_to_bootloader(void);
 
+/** @brief Switches the CPU between its low power and high performance configurations.
+  * @param high_performance true to raise the voltage regulator to performance level 2 and run the CPU at
+  *        16 MHz; false to return to performance level 0 and 4 MHz (or 8 MHz while USB is enabled).
+  * @note High performance draws several times the current, so only use it in short bursts, and not when
+  *       the battery is low. Peripherals clocked from the main clock must be reconfigured if they depend
+  *       on its frequency.
+  */
+void watch_set_cpu_high_performance(bool high_performance);
+
 /** @brief Disables the TRNG twice in order to work around silicon erratum 1.16.1.
  *  FIXME: find a better place for this, a couple of watch faces need it.
  */
@@ -67,4 +67,61 @@ void watch_disable_external_interrupts(void);
   */
 void watch_register_interrupt_callback(const uint8_t pin, watch_cb_t callback, eic_interrupt_trigger_t trigger);
 
+/** @brief Stops a pin's interrupt from reaching the CPU, without forgetting its callback.
+  * @details Use this to ignore a burst of edges you already know about, such as the contact bounce after a
+  *          button press. The EIC keeps watching the pin; it just doesn't interrupt.
+  * @param pin A pin previously configured with watch_register_interrupt_callback.
+  */
+void watch_mask_interrupt(const uint8_t pin);
+
+/** @brief Lets a pin masked with watch_mask_interrupt interrupt the CPU again.
+  * @details Edges seen while the pin was masked are dropped, so check the pin level if you need to know
+  *          whether it changed in the meantime.
+  * @param pin A pin previously configured with watch_register_interrupt_callback.
+  */
+void watch_unmask_interrupt(const uint8_t pin);
+
+/// @brief The rate at which edge capture timestamps count, in Hz.
+#define WATCH_CAPTURE_HZ 1024
+
+/// @brief The number of pins that can be captured at once; each takes a timer.
+#define WATCH_CAPTURE_MAX_PINS 2
+
+/** @brief Timestamps edges on up to WATCH_CAPTURE_MAX_PINS pins in hardware, at WATCH_CAPTURE_HZ.
+  * @details Each pin's EIC channel is routed through the event system to the capture input of its own timer
+  *          (TC2, TC3), which counts the 1024 Hz clock. The capture happens on the edge itself, whether or not the
+  *          CPU is awake or the interrupt is masked, so it leaves out the time it takes to wake up and run the
+  *          interrupt handler. The timers start together, so captures on any of the pins compare to within a tick
+  *          of the 1024 Hz clock. Timestamps are in the RTC counter's epoch, scaled up to WATCH_CAPTURE_HZ: the
+  *          timers are lined up with the RTC when capture is enabled, so captures compare with the scaled RTC
+  *          counter, or with captures from an earlier session, to within an RTC tick. The timers run in standby
+  *          while capture is enabled, which costs a little current; turn capture off when nothing needs it. They
+  *          stop in sleep mode, after which capture must be enabled again. The simulator has no timers to capture
+  *          with, and timestamps the callback instead, at the RTC counter's resolution.
+  * @param pins Pins already configured with watch_register_interrupt_callback. Any capture already enabled is
+  *             replaced.
+  * @param count The number of pins, at most WATCH_CAPTURE_MAX_PINS.
+  * @return false if a pin has no interrupt channel or there are too many pins; capture is then left off.
+  */
+bool watch_enable_capture(const uint8_t pins[], const uint8_t count);
+
+/// @brief Turns off edge capture and stops its timers.
+void watch_disable_capture(void);
+
+/** @brief Returns the timestamp of the oldest edge captured on a pin, and discards any later ones.
+  * @details Call this from the pin's interrupt callback. If no edge was captured, for instance because the pin
+  *          isn't being captured, this returns the current time in the same units.
+  * @param pin One of the pins passed to watch_enable_capture.
+  * @return The RTC counter at the edge, times WATCH_CAPTURE_HZ / watch_rtc_get_frequency(), plus the fraction
+  *         of an RTC tick. It wraps around when that product does.
+  */
+uint32_t watch_get_capture(const uint8_t pin);
+
+/** @brief Discards any edges captured on a pin.
+  * @details Use this after ignoring edges you know about, such as contact bounce while the pin was masked, so
+  *          that the next watch_get_capture returns the next edge rather than one of those.
+  * @param pin One of the pins passed to watch_enable_capture.
+  */
+void watch_discard_capture(const uint8_t pin);
+
 /// @}
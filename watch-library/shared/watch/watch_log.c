@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdarg.h>
+#include "watch_log.h"
+#include "watch_rtc.h"
+
+#if WATCH_LOG_BUFFER_WORDS & (WATCH_LOG_BUFFER_WORDS - 1)
+#error "WATCH_LOG_BUFFER_WORDS must be a power of two"
+#endif
+
+// Records are stored back to back; head and tail count words written and dropped since the last clear, so
+// head - tail is the number of words in use.
+static uint32_t _watch_log_buffer[WATCH_LOG_BUFFER_WORDS];
+static uint32_t _watch_log_head;
+static uint32_t _watch_log_tail;
+static uint32_t _watch_log_dropped;
+
+static inline uint8_t _watch_log_record_words(uint32_t header) {
+    return 2 + (header & 0x3);
+}
+
+void watch_log_write(const char *fmt, uint8_t num_args, ...) {
+    if (num_args > WATCH_LOG_MAX_ARGS) num_args = WATCH_LOG_MAX_ARGS;
+    uint8_t size = 2 + num_args;
+
+    // drop the oldest records until this one fits
+    while (_watch_log_head - _watch_log_tail + size > WATCH_LOG_BUFFER_WORDS) {
+        _watch_log_tail += _watch_log_record_words(_watch_log_buffer[_watch_log_tail % WATCH_LOG_BUFFER_WORDS]);
+        _watch_log_dropped++;
+    }
+
+    _watch_log_buffer[_watch_log_head++ % WATCH_LOG_BUFFER_WORDS] = (uint32_t)(uintptr_t)fmt | num_args;
+    _watch_log_buffer[_watch_log_head++ % WATCH_LOG_BUFFER_WORDS] = watch_rtc_get_counter();
+
+    va_list args;
+    va_start(args, num_args);
+    for (uint8_t i = 0; i < num_args; i++) {
+        _watch_log_buffer[_watch_log_head++ % WATCH_LOG_BUFFER_WORDS] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+}
+
+uint8_t watch_log_read(uint32_t *position, uint32_t *words) {
+    if (*position >= _watch_log_head - _watch_log_tail) return 0;
+    uint32_t index = _watch_log_tail + *position;
+
+    uint8_t size = _watch_log_record_words(_watch_log_buffer[index % WATCH_LOG_BUFFER_WORDS]);
+    for (uint8_t i = 0; i < size; i++) {
+        words[i] = _watch_log_buffer[(index + i) % WATCH_LOG_BUFFER_WORDS];
+    }
+    *position += size;
+
+    return size;
+}
+
+uint32_t watch_log_get_dropped(void) {
+    return _watch_log_dropped;
+}
+
+void watch_log_clear(void) {
+    _watch_log_head = 0;
+    _watch_log_tail = 0;
+    _watch_log_dropped = 0;
+}
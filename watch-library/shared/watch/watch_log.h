@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_log.h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup log Deferred Logging
+  * @brief This section covers a logger that is cheap enough to leave on in hot paths and production builds.
+  * @details A log call doesn't format anything. It appends a record to a ring buffer in RAM: the address of
+  *          its format string, the RTC counter, and up to three 32-bit arguments. The format strings live
+  *          in their own section of the firmware, .rodata.watch_log, so a host tool can render the records
+  *          later from the ELF file (see utils/watch_log/watch_log_decode.py). The shell's log command dumps
+  *          the ring as hex for that tool, or formats it directly in the simulator.
+  *          Arguments must be integers, characters or pointers: %s can't be rendered after the fact.
+  *          Calls below WATCH_LOG_LEVEL compile to nothing. When the ring is full, the oldest records are
+  *          dropped, and counted. Only log from thread context, not from interrupt handlers.
+  */
+/// @{
+
+#define WATCH_LOG_LEVEL_NONE 0
+#define WATCH_LOG_LEVEL_ERROR 1
+#define WATCH_LOG_LEVEL_WARN 2
+#define WATCH_LOG_LEVEL_INFO 3
+#define WATCH_LOG_LEVEL_DEBUG 4
+
+#ifndef WATCH_LOG_LEVEL
+#define WATCH_LOG_LEVEL WATCH_LOG_LEVEL_INFO
+#endif
+
+// Size of the ring buffer in 32-bit words. A record takes two words plus one per argument.
+#ifndef WATCH_LOG_BUFFER_WORDS
+#define WATCH_LOG_BUFFER_WORDS 256
+#endif
+
+#define WATCH_LOG_MAX_ARGS 3
+
+// Counts past WATCH_LOG_MAX_ARGS, so that a call with too many arguments trips the assertion in _WATCH_LOG rather
+// than quietly logging the wrong ones.
+#define _WATCH_LOG_NARGS(...) _WATCH_LOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _WATCH_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+// The format strings are word aligned, which leaves the low two bits of their address for the argument count.
+#define _WATCH_LOG(level, prefix, fmt, ...) do { \
+    _Static_assert(_WATCH_LOG_NARGS(__VA_ARGS__) <= WATCH_LOG_MAX_ARGS, "watch_log takes at most 3 arguments"); \
+    if ((level) <= WATCH_LOG_LEVEL) { \
+        static const char _watch_log_fmt[] __attribute__((section(".rodata.watch_log"), aligned(4))) = prefix fmt; \
+        watch_log_write(_watch_log_fmt, _WATCH_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__); \
+    } \
+} while (0)
+
+#define WATCH_LOG_ERROR(fmt, ...) _WATCH_LOG(WATCH_LOG_LEVEL_ERROR, "E ", fmt, ##__VA_ARGS__)
+#define WATCH_LOG_WARN(fmt, ...) _WATCH_LOG(WATCH_LOG_LEVEL_WARN, "W ", fmt, ##__VA_ARGS__)
+#define WATCH_LOG_INFO(fmt, ...) _WATCH_LOG(WATCH_LOG_LEVEL_INFO, "I ", fmt, ##__VA_ARGS__)
+#define WATCH_LOG_DEBUG(fmt, ...) _WATCH_LOG(WATCH_LOG_LEVEL_DEBUG, "D ", fmt, ##__VA_ARGS__)
+
+/** @brief Appends a record to the ring. Use the WATCH_LOG_* macros rather than calling this directly.
+  * @param fmt A word-aligned format string.
+  * @param num_args The number of arguments that follow, up to WATCH_LOG_MAX_ARGS.
+  */
+void watch_log_write(const char *fmt, uint8_t num_args, ...);
+
+/** @brief Reads a record out of the ring, oldest first.
+  * @param position Where to start; 0 for the oldest record. Updated to point past the record.
+  * @param words Filled in with the record: the format string address with the argument count in its low two
+  *              bits, the RTC counter, then the arguments. Must have room for 2 + WATCH_LOG_MAX_ARGS words.
+  * @return The number of words in the record, or 0 if there are no more.
+  */
+uint8_t watch_log_read(uint32_t *position, uint32_t *words);
+
+/// @brief Returns the number of records dropped to make room for newer ones.
+uint32_t watch_log_get_dropped(void);
+
+/// @brief Empties the ring.
+void watch_log_clear(void);
+
+/// @}
@@ -35,4 +35,10 @@ void _watch_enable_usb(void);
 /// Initializes the real-time clock peripheral. Implemented in watch_rtc.c
 void _watch_rtc_init(void);
 
+/// Returns the frequency the main clock (GCLK0) was last set to, in Hz.
+uint32_t _watch_get_cpu_frequency(void);
+
+/// Keeps the TCC counting at 1 MHz after the main clock changes speed. Implemented in watch_tcc.c
+void _watch_update_tcc_prescaler(void);
+
 #endif
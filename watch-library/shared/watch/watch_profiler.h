@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_profiler.h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup profiler Sampling Profiler
+  * @brief This section covers a statistical profiler, for finding out where the CPU spends its cycles.
+  * @details While the profiler runs, a spare timer (TC1) interrupts the CPU every WATCH_PROFILER_PERIOD_CYCLES
+  *          CPU cycles, and its handler counts the program counter it interrupted in a small hash table. The
+  *          timer is clocked from the CPU clock, so the samples are spread over cycles rather than time, whatever
+  *          speed the CPU is running at, and the timer stops along with the CPU in standby. Time spent in an
+  *          interrupt handler shows up under that handler; time halted in IDLE sleep shows up at the WFI.
+  *          The shell's prof command controls the profiler and dumps the table as hex for
+  *          utils/watch_prof/watch_prof_report.py, which maps the addresses onto functions from the ELF file.
+  *
+  *          Overhead is bounded by the handler, which does a fixed amount of work plus at most
+  *          WATCH_PROFILER_MAX_PROBES table lookups: about 70 cycles per sample, or 0.4% of the CPU at any
+  *          clock speed (at 4 MHz, one 17 us interrupt every 4.1 ms). `prof overhead` measures it on the watch.
+  *          The table is allocated when the profiler first starts, and freed by watch_profiler_free.
+  *          The simulator has no program counter to sample, so there the profiler never starts.
+  */
+/// @{
+
+// Distinct program counters the table can hold. Must be a power of two. Each takes six bytes.
+#ifndef WATCH_PROFILER_SLOTS
+#define WATCH_PROFILER_SLOTS 256
+#endif
+
+// Slots the handler looks at before giving up on a sample and counting it as dropped.
+#define WATCH_PROFILER_MAX_PROBES 4
+
+// CPU cycles between samples: the timer counts GCLK0 through a prescaler of 1024, with a period of 16.
+#define WATCH_PROFILER_PERIOD_CYCLES 16384
+
+/** @brief Starts sampling, adding to whatever the table already holds.
+  * @return false if the table could not be allocated, or in the simulator.
+  */
+bool watch_profiler_start(void);
+
+/// @brief Stops sampling. The table keeps its contents.
+void watch_profiler_stop(void);
+
+/// @brief Returns true if the profiler is sampling.
+bool watch_profiler_is_running(void);
+
+/// @brief Stops sampling and releases the table.
+void watch_profiler_free(void);
+
+/** @brief Reads the next used slot of the table.
+  * @param position Where to start; 0 for the first slot. Updated to point past the slot that was read.
+  * @param pc Filled in with the sampled program counter.
+  * @param count Filled in with the number of samples at that address; it sticks at 65535.
+  * @return false if there are no more slots.
+  */
+bool watch_profiler_read(uint16_t *position, uint32_t *pc, uint16_t *count);
+
+/// @brief Returns the number of samples taken since the table was allocated, including dropped ones.
+uint32_t watch_profiler_get_samples(void);
+
+/// @brief Returns the number of samples dropped because their slot could not be found or made.
+uint32_t watch_profiler_get_dropped(void);
+
+/// @}
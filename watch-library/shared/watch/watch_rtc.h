@@ -104,7 +104,7 @@ uint32_t watch_rtc_get_ticks_per_minute(void);
   * @param callback The function you wish to have called when the target counter is reached. If this value is NULL, the comp
   *                 interrupt will still be enabled, but no callback function will be called.
   * @param counter The time that you wish to match. The date is currently ignored.
-  * @param index We can have up to 8 active callbacks at a time. This parameter specifies which of the 8 callbacks should be set.
+  * @param index We can have up to 16 active callbacks at a time. This parameter specifies which of the 16 callbacks should be set.
   * @details The hardware RTC provides us with single interrupt that fires when the RTC counter matches a target counter COMP0.
   *          With a little bit of logic, we can provide multiple active compare callbacks. Every time a comp callback is 
   *          registered/disabled/fired we iterate over all the active comp callbacks and set the hardware COMP0 counter
@@ -191,6 +191,14 @@ void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask);
   */
 void watch_rtc_disable_all_periodic_callbacks(void);
 
+/** @brief Returns how many periodic callbacks were skipped because the RTC fell behind.
+  * @details When callbacks come due faster than they can be dispatched (a long callback, a throttled browser tab,
+  *          the counter being set), each periodic callback fires once, for its latest period, and the periods in
+  *          between are counted here instead of being replayed. Only the simulator can fall behind like this;
+  *          on hardware, this is always 0.
+  */
+uint32_t watch_rtc_get_missed_periodic_callbacks(void);
+
 /** @brief Enable/disable RTC while in-flight. This is quite dangerous operation, so we repeat writing register twice.
  * Used when temporarily pausing RTC when adjusting subsecond, which are not accessible otherwise.
   */
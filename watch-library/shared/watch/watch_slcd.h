@@ -116,6 +116,14 @@ void watch_set_pixel(uint8_t com, uint8_t seg);
   */
 void watch_clear_pixel(uint8_t com, uint8_t seg);
 
+/** @brief Reads back a pixel. Returns the state last written to the segment controller, which is what the
+  *        display shows, not counting blinking or animations run by the segment controller itself.
+  * @param com the common pin, numbered from 0-2.
+  * @param seg the segment pin, numbered from 0-23.
+  * @return true if the pixel is set, false otherwise.
+  */
+bool watch_get_pixel(uint8_t com, uint8_t seg);
+
 /** @brief Clears all segments of the display, including incicators and the colon.
   */
 void watch_clear_display(void);
@@ -26,6 +26,7 @@
 
 #include "watch_extint.h"
 #include "watch_main_loop.h"
+#include "watch_rtc.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -39,6 +40,9 @@ static watch_cb_t external_interrupt_light_callback = NULL;
 static eic_interrupt_trigger_t external_interrupt_light_trigger = INTERRUPT_TRIGGER_NONE;
 static watch_cb_t external_interrupt_alarm_callback = NULL;
 static eic_interrupt_trigger_t external_interrupt_alarm_trigger = INTERRUPT_TRIGGER_NONE;
+static bool external_interrupt_mode_masked = false;
+static bool external_interrupt_light_masked = false;
+static bool external_interrupt_alarm_masked = false;
 
 #define BTN_ID_ALARM 3
 #define BTN_ID_LIGHT 1
@@ -153,6 +157,7 @@ void watch_disable_external_interrupts(void) {
 static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, eic_interrupt_trigger_t event) {
     watch_cb_t callback;
     eic_interrupt_trigger_t trigger;
+    bool masked;
     const bool level = (event & INTERRUPT_TRIGGER_RISING) != 0;
 
     switch (button_id) {
@@ -160,16 +165,19 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, eic_inte
             HAL_GPIO_BTN_MODE_write(level);
             callback = external_interrupt_mode_callback;
             trigger = external_interrupt_mode_trigger;
+            masked = external_interrupt_mode_masked;
             break;
         case BTN_ID_LIGHT:
             HAL_GPIO_BTN_LIGHT_write(level);
             callback = external_interrupt_light_callback;
             trigger = external_interrupt_light_trigger;
+            masked = external_interrupt_light_masked;
             break;
         case BTN_ID_ALARM:
             HAL_GPIO_BTN_ALARM_write(level);
             callback = external_interrupt_alarm_callback;
             trigger = external_interrupt_alarm_trigger;
+            masked = external_interrupt_alarm_masked;
             break;
         default:
             return EM_FALSE;
@@ -185,7 +193,7 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, eic_inte
         return EM_FALSE;
     }
 
-    if (callback && (event & trigger) != 0) {
+    if (callback && !masked && (event & trigger) != 0) {
         callback();
         resume_main_loop();
     }
@@ -197,11 +205,51 @@ void watch_register_interrupt_callback(const uint8_t pin, watch_cb_t callback, e
     if (pin == HAL_GPIO_BTN_MODE_pin()) {
         external_interrupt_mode_callback = callback;
         external_interrupt_mode_trigger = trigger;
+        external_interrupt_mode_masked = false;
     } else if (pin == HAL_GPIO_BTN_LIGHT_pin()) {
         external_interrupt_light_callback = callback;
         external_interrupt_light_trigger = trigger;
+        external_interrupt_light_masked = false;
     } else if (pin == HAL_GPIO_BTN_ALARM_pin()) {
         external_interrupt_alarm_callback = callback;
         external_interrupt_alarm_trigger = trigger;
+        external_interrupt_alarm_masked = false;
     }
 }
+
+static void watch_set_interrupt_masked(const uint8_t pin, bool masked) {
+    if (pin == HAL_GPIO_BTN_MODE_pin()) {
+        external_interrupt_mode_masked = masked;
+    } else if (pin == HAL_GPIO_BTN_LIGHT_pin()) {
+        external_interrupt_light_masked = masked;
+    } else if (pin == HAL_GPIO_BTN_ALARM_pin()) {
+        external_interrupt_alarm_masked = masked;
+    }
+}
+
+void watch_mask_interrupt(const uint8_t pin) {
+    watch_set_interrupt_masked(pin, true);
+}
+
+void watch_unmask_interrupt(const uint8_t pin) {
+    watch_set_interrupt_masked(pin, false);
+}
+
+// There are no timers to capture with: a captured pin is timestamped when its callback asks, which in the simulator
+// is right after the key or mouse event, at the RTC counter's resolution.
+bool watch_enable_capture(const uint8_t pins[], const uint8_t count) {
+    (void) pins;
+    return count <= WATCH_CAPTURE_MAX_PINS;
+}
+
+void watch_disable_capture(void) {
+}
+
+uint32_t watch_get_capture(const uint8_t pin) {
+    (void) pin;
+    return watch_rtc_get_counter() * (WATCH_CAPTURE_HZ / watch_rtc_get_frequency());
+}
+
+void watch_discard_capture(const uint8_t pin) {
+    (void) pin;
+}
@@ -53,6 +53,10 @@ int _gettimeofday(struct timeval *tv, void *tzvp) {
 
 void _watch_enable_usb(void) {}
 
+void watch_set_cpu_high_performance(bool high_performance) {
+    (void) high_performance;
+}
+
 void watch_disable_TRNG() {}
 
 // this function ends up getting called by printf to log stuff to the USB console.
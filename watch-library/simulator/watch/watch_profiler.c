@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Second Movement Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_profiler.h"
+
+// There's no program counter to sample in the simulator; profile the native build with the browser's tools instead.
+
+bool watch_profiler_start(void) {
+    return false;
+}
+
+void watch_profiler_stop(void) {
+}
+
+bool watch_profiler_is_running(void) {
+    return false;
+}
+
+void watch_profiler_free(void) {
+}
+
+bool watch_profiler_read(uint16_t *position, uint32_t *pc, uint16_t *count) {
+    (void) position;
+    (void) pc;
+    (void) count;
+    return false;
+}
+
+uint32_t watch_profiler_get_samples(void) {
+    return 0;
+}
+
+uint32_t watch_profiler_get_dropped(void) {
+    return 0;
+}
@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 #include <limits.h>
+#include <math.h>
 
 #include "watch_rtc.h"
 #include "watch_main_loop.h"
@@ -35,11 +36,19 @@ static const uint32_t RTC_CNT_SUBSECOND_MASK = RTC_CNT_HZ - 1;
 static const uint32_t RTC_CNT_DIV = 7;
 static const uint32_t RTC_CNT_TICKS_PER_MINUTE = RTC_CNT_HZ * 60;
 
-static uint32_t counter_interval;
+static bool rtc_enabled;
+// The counter is derived on demand from performance.now(), relative to this origin (in ms).
+static double counter_origin_ms;
+// Value of the counter while the RTC is disabled, or while a callback is being dispatched.
 static uint32_t counter;
+// True while callbacks are being fired, so they observe the counter value they were scheduled for.
+static bool dispatching;
+// All periodic and comp events up to (and including) this counter value have been processed.
+static uint32_t last_processed_counter;
+static uint32_t missed_periodic_callbacks;
 static uint32_t reference_timestamp;
 
-#define WATCH_RTC_N_COMP_CB 8
+#define WATCH_RTC_N_COMP_CB 16
 
 typedef struct {
     volatile uint32_t counter;
@@ -47,11 +56,15 @@ typedef struct {
     volatile bool enabled;
 } comp_cb_t;
 
-static double time_offset = 0;
 watch_cb_t tick_callbacks[8];
 comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
 
 static uint32_t scheduled_comp_counter;
+static bool comp_scheduled;
+
+// Instead of waking up 128 times per second, we arm a single timeout for the next counter value
+// at which something is due, just like the hardware only interrupts on enabled periodic or comp events.
+static long wakeup_timeout_id = 0;
 
 static long alarm_interval_id = -1;
 static long alarm_timeout_id = -1;
@@ -61,12 +74,21 @@ watch_cb_t btn_alarm_callback;
 watch_cb_t a2_callback;
 watch_cb_t a4_callback;
 
-static void _watch_increase_counter(void *userData);
-static void _watch_process_periodic_callbacks(void);
+static void _watch_rtc_fire(void *userData);
+static void _watch_rtc_arm_next_wakeup(void);
+static void _watch_process_periodic_callbacks(uint32_t now);
 static void _watch_process_comp_callbacks(void);
 
+static uint32_t _watch_rtc_live_counter(void) {
+    if (!rtc_enabled) return counter;
+    double elapsed_ms = emscripten_get_now() - counter_origin_ms;
+    if (elapsed_ms < 0) elapsed_ms = 0;
+    // go through a 64-bit integer so the counter wraps around like the hardware one.
+    return (uint32_t)(uint64_t)(elapsed_ms * RTC_CNT_HZ / 1000.0);
+}
+
 bool _watch_rtc_is_enabled(void) {
-    return counter_interval;
+    return rtc_enabled;
 }
 
 void _watch_rtc_init(void) {
@@ -81,8 +103,11 @@ void _watch_rtc_init(void) {
     }
 
     scheduled_comp_counter = 0;
+    comp_scheduled = false;
     counter = 0;
-    counter_interval = 0;
+    last_processed_counter = 0;
+    dispatching = false;
+    rtc_enabled = false;
 
     watch_rtc_set_date_time(watch_get_init_date_time());
     watch_rtc_enable(true);
@@ -109,7 +134,8 @@ unix_timestamp_t watch_rtc_get_unix_time(void) {
 }
 
 rtc_counter_t watch_rtc_get_counter(void) {
-    return counter;
+    if (dispatching) return counter;
+    return _watch_rtc_live_counter();
 }
 
 uint32_t watch_rtc_get_frequency(void) {
@@ -164,19 +190,111 @@ void watch_rtc_disable_tick_callback(void) {
     watch_rtc_disable_periodic_callback(1);
 }
 
-static void _watch_increase_counter(void *userData) {
+static uint32_t _watch_rtc_next_periodic_counter(uint32_t after, uint8_t per_n) {
+    // 128Hz fires on every counter value, PERn fires when the counter is an odd multiple of 2^(n-1) (see table below).
+    if (per_n == 0) return after + 1;
+
+    uint32_t period = 1 << per_n;
+    uint32_t next = (after & ~(period - 1)) + (period >> 1);
+    if ((int32_t)(next - after) <= 0) next += period;
+
+    return next;
+}
+
+static bool _watch_rtc_next_event_counter(uint32_t after, uint32_t *next_counter) {
+    bool found = false;
+    uint32_t soonest = 0;
+
+    for (uint8_t per_n = 0; per_n < 8; per_n++) {
+        if (tick_callbacks[per_n] == NULL) continue;
+        uint32_t candidate = _watch_rtc_next_periodic_counter(after, per_n);
+        if (!found || (int32_t)(candidate - soonest) < 0) {
+            soonest = candidate;
+            found = true;
+        }
+        // the 128 Hz callback is always the soonest, no need to look further.
+        if (per_n == 0) break;
+    }
+
+    if (comp_scheduled) {
+        // In hardware the interrupt fires one tick after the matching counter
+        uint32_t candidate = scheduled_comp_counter + 1;
+        if (!found || (int32_t)(candidate - soonest) < 0) {
+            soonest = candidate;
+            found = true;
+        }
+    }
+
+    *next_counter = soonest;
+    return found;
+}
+
+static void _watch_rtc_fire(void *userData) {
     (void) userData;
 
-    counter += 1;
-    // Fire the periodic callbacks that match this counter
-    _watch_process_periodic_callbacks();
-    // Fire the comp callbacks that match this counter
-    _watch_process_comp_callbacks();
+    wakeup_timeout_id = 0;
+    if (!rtc_enabled) return;
+
+    uint32_t now = _watch_rtc_live_counter();
+    bool fired = false;
 
-    resume_main_loop();
+    // If the browser throttled us (i.e. a background tab), don't walk a backlog of stale ticks: jump to the last
+    // second, which still holds the latest period of every periodic callback, and count the ones jumped over.
+    // A comp callback that became due in the meantime still fires, since it is a one-shot deadline.
+    if ((now - last_processed_counter) > RTC_CNT_HZ) {
+        for (uint8_t per_n = 0; per_n < 8; per_n++) {
+            if (tick_callbacks[per_n] == NULL) continue;
+            missed_periodic_callbacks += (now - RTC_CNT_HZ - last_processed_counter) >> per_n;
+        }
+        last_processed_counter = now - RTC_CNT_HZ;
+    }
+
+    uint32_t next;
+    while (_watch_rtc_next_event_counter(last_processed_counter, &next) && (int32_t)(next - now) <= 0) {
+        // Callbacks observe the counter value at which they were due, as they would on hardware.
+        counter = next;
+        dispatching = true;
+        // Fire the periodic callbacks that match this counter
+        _watch_process_periodic_callbacks(now);
+        // Fire the comp callbacks that match this counter
+        _watch_process_comp_callbacks();
+        dispatching = false;
+        if ((int32_t)(next - last_processed_counter) > 0) last_processed_counter = next;
+        fired = true;
+    }
+
+    last_processed_counter = now;
+    _watch_rtc_arm_next_wakeup();
+
+    if (fired) {
+        resume_main_loop();
+    }
+}
+
+static void _watch_rtc_arm_next_wakeup(void) {
+    if (wakeup_timeout_id) {
+        emscripten_clear_timeout(wakeup_timeout_id);
+        wakeup_timeout_id = 0;
+    }
+
+    // Callbacks may register/disable other callbacks while being dispatched, _watch_rtc_fire re-arms when done.
+    if (!rtc_enabled || dispatching) return;
+
+    uint32_t next;
+    if (!_watch_rtc_next_event_counter(last_processed_counter, &next)) return;
+
+    // time left until the counter reaches the target value, accounting for the fraction of the current tick already elapsed.
+    double elapsed_ticks = (emscripten_get_now() - counter_origin_ms) * RTC_CNT_HZ / 1000.0;
+    double remaining_ticks = (double)(int32_t)(next - _watch_rtc_live_counter()) - (elapsed_ticks - floor(elapsed_ticks));
+    double delay_ms = remaining_ticks * 1000.0 / RTC_CNT_HZ;
+    if (delay_ms < 0) delay_ms = 0;
+
+    wakeup_timeout_id = emscripten_set_timeout(_watch_rtc_fire, delay_ms, NULL);
 }
 
-static void _watch_process_periodic_callbacks(void) {
+// Fires the periodic callbacks that match the counter, unless their next period is also due by now: then this one
+// was missed, and is only counted.
+static void _watch_process_periodic_callbacks(uint32_t now) {
     /* It looks weird but it follows the way the hardware triggers periodic interrupts.
      * For 128hz counter periodic interrupts fire at these tick values:
      * 1Hz:   64
@@ -207,15 +325,21 @@ static void _watch_process_periodic_callbacks(void) {
     }
 
     if (tick_callbacks[per_n]) {
-        tick_callbacks[per_n]();
+        if ((int32_t)(counter + (1 << per_n) - now) <= 0) missed_periodic_callbacks++;
+        else tick_callbacks[per_n]();
     }
 
     // 128Hz is always a match
     if (per_n != 0 && tick_callbacks[0]) {
-        tick_callbacks[0]();
+        if ((int32_t)(counter + 1 - now) <= 0) missed_periodic_callbacks++;
+        else tick_callbacks[0]();
     }
 }
 
+uint32_t watch_rtc_get_missed_periodic_callbacks(void) {
+    return missed_periodic_callbacks;
+}
+
 static void _watch_process_comp_callbacks(void) {
     // In hardware the interrupt fires one tick after the matching counter
     if (counter == (scheduled_comp_counter + 1)) {
@@ -241,12 +365,16 @@ void watch_rtc_register_periodic_callback(watch_cb_t callback, uint8_t frequency
     uint8_t per_n = __builtin_clz(tmp);
 
     tick_callbacks[per_n] = callback;
+
+    _watch_rtc_arm_next_wakeup();
 }
 
 void watch_rtc_disable_periodic_callback(uint8_t frequency) {
     if (__builtin_popcount(frequency) != 1) return;
     uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
     tick_callbacks[per_n] = NULL;
+
+    _watch_rtc_arm_next_wakeup();
 }
 
 void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
@@ -255,6 +383,8 @@ void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
             tick_callbacks[i] = NULL;
         }
     }
+
+    _watch_rtc_arm_next_wakeup();
 }
 
 void watch_rtc_disable_all_periodic_callbacks(void) {
@@ -305,7 +435,7 @@ void watch_rtc_schedule_next_comp(void) {
     rtc_counter_t curr_counter = watch_rtc_get_counter();
     // If there is already a pending comp interrupt for this very tick, let it fire
     // And this function will be called again as soon as the interrupt fires.
-    if (curr_counter == scheduled_comp_counter) {
+    if (comp_scheduled && curr_counter == scheduled_comp_counter) {
         return;
     }
 
@@ -333,22 +463,28 @@ void watch_rtc_schedule_next_comp(void) {
     } else {
         scheduled_comp_counter = curr_counter - 2;
     }
+    comp_scheduled = schedule_any;
+
+    _watch_rtc_arm_next_wakeup();
 }
 
 void watch_rtc_enable(bool en)
 {
     // Nothing to do cases
-    if ((en && counter_interval) || (!en && !counter_interval)) {
+    if (en == rtc_enabled) {
         return;
     }
 
     if (en) {
-        // Very bad way to keep time, but okay way to emulates the hardware.
-        double ms = 1000.0 / (double)RTC_CNT_HZ; // in msec
-        counter_interval = emscripten_set_interval(_watch_increase_counter, ms, NULL);
+        // Resume counting from where we stopped: the counter is derived from the monotonic clock.
+        counter_origin_ms = emscripten_get_now() - (double)counter * 1000.0 / (double)RTC_CNT_HZ;
+        last_processed_counter = counter;
+        rtc_enabled = true;
+        _watch_rtc_arm_next_wakeup();
     } else {
-        emscripten_clear_interval(counter_interval);
-        counter_interval = 0;
+        counter = _watch_rtc_live_counter();
+        rtc_enabled = false;
+        _watch_rtc_arm_next_wakeup();
     }
 }
 
@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "watch_slcd.h"
 #include "watch_common_display.h"
 
@@ -31,12 +33,67 @@
 //////////////////////////////////////////////////////////////////////////////////////////
 // Segmented Display
 
+// The simulated SLCD has the same number of COM and SEG lines as the hardware one.
+#define SIM_SLCD_NUM_COMS 8
+#define SIM_SLCD_NUM_SEGS 48
+
 static char blink_character;
 static bool blink_state;
 static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
 
+// Pixel writes land in this shadow buffer; the DOM is only touched once per animation frame,
+// and only for the segments whose state actually changed since the last commit.
+static uint8_t _pixels[SIM_SLCD_NUM_COMS * SIM_SLCD_NUM_SEGS];
+static uint8_t _committed_pixels[SIM_SLCD_NUM_COMS * SIM_SLCD_NUM_SEGS];
+static bool _segment_map_built = false;
+static bool _commit_pending = false;
+
+static void _watch_build_segment_map(void) {
+    if (_segment_map_built) return;
+
+    // Look up the SVG elements for every (com, seg) pair once, instead of running a selector query per pixel write.
+    EM_ASM({
+        const segs = $0;
+        Module.slcdSegments = [];
+        document.querySelectorAll("[data-com][data-seg]").forEach((e) => {
+            const index = parseInt(e.dataset.com) * segs + parseInt(e.dataset.seg);
+            (Module.slcdSegments[index] = Module.slcdSegments[index] || []).push(e);
+            e.style.opacity = 0;
+        });
+    }, SIM_SLCD_NUM_SEGS);
+
+    memset(_committed_pixels, 0, sizeof(_committed_pixels));
+    _segment_map_built = true;
+}
+
+static EM_BOOL _watch_commit_display(double time, void *userData) {
+    (void) time;
+    (void) userData;
+
+    _commit_pending = false;
+    if (!_segment_map_built) return EM_FALSE;
+
+    for (uint16_t i = 0; i < sizeof(_pixels); i++) {
+        if (_pixels[i] != _committed_pixels[i]) {
+            _committed_pixels[i] = _pixels[i];
+            EM_ASM({
+                const elements = Module.slcdSegments[$0];
+                if (elements) elements.forEach((e) => e.style.opacity = $1);
+            }, i, _pixels[i]);
+        }
+    }
+
+    return EM_FALSE;
+}
+
+static inline void _watch_request_commit(void) {
+    if (_commit_pending) return;
+    _commit_pending = true;
+    emscripten_request_animation_frame(_watch_commit_display, NULL);
+}
+
 watch_lcd_type_t watch_get_lcd_type(void) {
 #if defined(FORCE_CUSTOM_LCD_TYPE)
     return WATCH_LCD_TYPE_CUSTOM;
@@ -58,6 +115,7 @@ void watch_enable_display(void) {
     EM_ASM({document.getElementById("classic").style.display = "";});
 #endif
 
+    _watch_build_segment_map();
     watch_clear_display();
 }
 
@@ -68,24 +126,25 @@ void watch_disable_display(void) {
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
+    if (com >= SIM_SLCD_NUM_COMS || seg >= SIM_SLCD_NUM_SEGS) return;
+    _pixels[com * SIM_SLCD_NUM_SEGS + seg] = 1;
+    _watch_request_commit();
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
+    if (com >= SIM_SLCD_NUM_COMS || seg >= SIM_SLCD_NUM_SEGS) return;
+    _pixels[com * SIM_SLCD_NUM_SEGS + seg] = 0;
+    _watch_request_commit();
+}
+
+bool watch_get_pixel(uint8_t com, uint8_t seg) {
+    if (com >= SIM_SLCD_NUM_COMS || seg >= SIM_SLCD_NUM_SEGS) return false;
+    return _pixels[com * SIM_SLCD_NUM_SEGS + seg];
 }
 
 void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+    memset(_pixels, 0, sizeof(_pixels));
+    _watch_request_commit();
 }
 
 static void watch_invoke_blink_callback(void *userData) {